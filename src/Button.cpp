@@ -22,7 +22,7 @@ Button::Button(QWidget* parent)
 				  "{"
 				  "  background-color: rgba(0, 100, 0, 128);"
 				  "}");
-	setFixedWidth(CardWidget::WIDTH);
+	setFixedWidth(CardItem::WIDTH);
 	setFixedHeight(46);
 	setIconSize({32, 32});
 }
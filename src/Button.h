@@ -5,7 +5,7 @@
 #ifndef BUTTON_H
 #define BUTTON_H
 
-#include "cardwidget.h"
+#include "carditem.h"
 #include <QPushButton>
 
 
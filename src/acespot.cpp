@@ -17,10 +17,9 @@
 
 #include "acespot.h"
 #include "board.h"
-#include "cardspotproxy.h"
-#include "cardwidget.h"
+#include "cardspotitem.h"
+#include "rules.h"
 
-#include <QLabel>
 #include <QMetaEnum>
 
 /*!
@@ -31,24 +30,15 @@ AceSpot::AceSpot(Board* board, Card::Suit suit)
 	: CardSpot(board)
 	, m_suit(suit)
 {
-	mProxy = new CardSpotProxy(this);
-	mProxy->setData(0, QVariant("acespot"));
-	mProxy->setData(1, QVariant(m_suit));
+	mItem = new CardSpotItem(this);
+	mItem->setData(0, QVariant("acespot"));
+	mItem->setData(1, QVariant(m_suit));
 
 	auto backgroundImage = QPixmap(QString(":/suits/%1").arg(Card::suitName(suit)));
 	backgroundImage = backgroundImage.scaled(backgroundImage.width()/2.0, backgroundImage.height()/2.0);
+	mItem->setPixmap(backgroundImage);
 
-	auto* widget = new QLabel();
-	widget->resize(CardWidget::WIDTH, CardWidget::HEIGHT);
-	widget->setStyleSheet(QString("background-color:transparent;"
-								  "border: 6px solid darkGreen;"
-								  "border-radius: %1px;")
-							  .arg(CardWidget::BORDER_RADIUS));
-	widget->setPixmap(backgroundImage);
-	widget->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-
-	mProxy->setWidget(widget);
-	mBoard->addItem(mProxy);
+	mBoard->addSpot(mItem);
 }
 
 /*!
@@ -58,7 +48,7 @@ AceSpot::AceSpot(Board* board, Card::Suit suit)
  */
 bool AceSpot::canStackCard(Card* card)
 {
-	if (isEmpty() && card->isMovable() && card->getValue() == Card::Value::ACE && card->getSuit() == m_suit)
+	if (isEmpty() && isNextOnFoundation(m_suit - 1, 0, card->getId()) && card->isMovable())
 	{
 		return true;
 	}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "autoplay.h"
+
+#include <array>
+#include <bit>
+
+#include "rules.h"
+
+namespace
+{
+	//! [foundation]: bit mask of the foundations of the other color
+	constexpr std::array<unsigned int, NB_SUITS> OPPOSITE_FOUNDATIONS = []
+	{
+		std::array<unsigned int, NB_SUITS> table{};
+		for (int foundation = 0; foundation < NB_SUITS; foundation++)
+		{
+			for (int other = 0; other < NB_SUITS; other++)
+			{
+				if (cardIsRed(cardId(foundation + 1, VALUE_ACE)) != cardIsRed(cardId(other + 1, VALUE_ACE)))
+				{
+					table[foundation] |= 1u << other;
+				}
+			}
+		}
+		return table;
+	}();
+} // namespace
+
+Autoplay::Autoplay(Mode mode) noexcept
+	: m_mode(mode)
+{
+}
+
+/*!
+ * \brief Move the cards the mode allows to the foundations, until none is left
+ * \param state The position to update
+ * \param moves Receives the moves played, one card each
+ */
+void Autoplay::run(GameState& state, std::vector<StateMove>& moves) const
+{
+	if (m_mode == Mode::Off)
+	{
+		return;
+	}
+
+	// slot of each card at the top of a column or in a freecell, -1 for the others, and the
+	// foundations whose next card may be playable
+	std::array<std::int8_t, NB_CARDS> slots;
+	unsigned int					  pending = 0;
+	slots.fill(-1);
+	for (int slot = 0; slot < GameState::FIRST_FOUNDATION; slot++)
+	{
+		if (CardId top = state.topCard(slot); top != NO_CARD)
+		{
+			slots[top] = static_cast<std::int8_t>(slot);
+			if (isNextOnFoundation(foundationIndex(top), state.foundation(foundationIndex(top)), top))
+			{
+				pending |= 1u << foundationIndex(top);
+			}
+		}
+	}
+
+	while (pending)
+	{
+		int foundation = std::countr_zero(pending);
+		pending &= pending - 1;
+
+		CardId card = FOUNDATION_NEXT[foundation][state.foundation(foundation)];
+		if (card == NO_CARD || slots[card] < 0 || (m_mode == Mode::Safe && !isSafe(state, card)))
+		{
+			continue;
+		}
+
+		int		  slot = slots[card];
+		StateMove move{static_cast<std::uint8_t>(slot), static_cast<std::uint8_t>(GameState::FIRST_FOUNDATION + foundation), 1};
+		state.apply(move);
+		moves.push_back(move);
+		slots[card] = -1;
+
+		// the foundation may take its next card, the uncovered card may go to its own one, and
+		// the cards of the other color may not be needed anymore
+		pending |= 1u << foundation;
+		if (CardId top = state.topCard(slot); top != NO_CARD)
+		{
+			slots[top] = static_cast<std::int8_t>(slot);
+			pending |= 1u << foundationIndex(top);
+		}
+		if (m_mode == Mode::Safe)
+		{
+			pending |= OPPOSITE_FOUNDATIONS[foundation];
+		}
+	}
+}
+
+void Autoplay::setMode(Mode mode) noexcept
+{
+	m_mode = mode;
+}
+
+Autoplay::Mode Autoplay::mode() const noexcept
+{
+	return m_mode;
+}
+
+/*!
+ * \brief Check if a card can go to its foundation without being needed in the columns anymore
+ *
+ * A card is safe once no lower card of the other color may have to be stacked on it: both
+ * foundations of the other color hold at least the card's value - 1.
+ */
+bool Autoplay::isSafe(const GameState& state, CardId card) noexcept
+{
+	int value = cardValue(card);
+	if (value <= 2)
+	{
+		return true;
+	}
+
+	unsigned int opposite = OPPOSITE_FOUNDATIONS[foundationIndex(card)];
+	for (int foundation = 0; foundation < NB_SUITS; foundation++)
+	{
+		if ((opposite >> foundation & 1) && state.foundation(foundation) < value - 1)
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AUTOPLAY_H
+#define AUTOPLAY_H
+
+#include <vector>
+
+#include "gamestate.h"
+
+/*!
+ * \brief Moves cards to the foundations without the player asking
+ *
+ * One call plays the whole closure: every card the mode allows, including the ones uncovered
+ * or allowed by the previous moves. A move only raises a foundation, which can only make more
+ * cards playable, so the closure doesn't depend on the order of the moves. The engine keeps a
+ * worklist of the foundations whose next card may have become playable, rather than scanning
+ * the board again after each move.
+ */
+class Autoplay
+{
+public:
+
+	enum class Mode
+	{
+		Off,  //!< Never move a card
+		Safe, //!< Only move the cards the columns can't need anymore, see isSafe()
+		All,  //!< Move every card that fits on its foundation
+	};
+
+public:
+
+	explicit Autoplay(Mode mode = Mode::Safe) noexcept;
+
+	void run(GameState& state, std::vector<StateMove>& moves) const;
+
+	void			   setMode(Mode mode) noexcept;
+	[[nodiscard]] Mode mode() const noexcept;
+
+	static bool isSafe(const GameState& state, CardId card) noexcept;
+
+protected:
+
+	Mode m_mode;
+};
+
+#endif // AUTOPLAY_H
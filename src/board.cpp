@@ -18,17 +18,27 @@
 #include "board.h"
 #include "acespot.h"
 #include "boardscene.h"
-#include "cardproxy.h"
-#include "cardwidget.h"
+#include "carditem.h"
 #include "columnspot.h"
 #include "freecell.h"
+#include "solver.h"
 
+#include <QCoreApplication>
 #include <QGraphicsItem>
+#include <QGraphicsProxyWidget>
 #include <QGraphicsView>
 #include <QInputDialog>
+#include <QMessageBox>
+#include <QParallelAnimationGroup>
 #include <QPointF>
+#include <QPropertyAnimation>
+#include <QSignalBlocker>
+#include <QSlider>
+#include <QStandardPaths>
+#include <QThread>
 #include <QTimer>
 
+#include <algorithm>
 #include <random>
 #include <thread>
 
@@ -64,28 +74,30 @@ Board::Board()
 	QBrush backgroundBrush(backgroundImage);
 	backgroundBrush.setStyle(Qt::TexturePattern); // Set the brush to tile the image
 
-	// Set the background brush of the view
-	mBoardWidget->setBackgroundBrush(backgroundBrush);
-
 	// Optional: Disable the default scrollbars
 	mBoardWidget->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 	mBoardWidget->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
-	qreal minWidth	= 9 * CardWidget::WIDTH + 12 * SPACING;
-	qreal minHeight = 4 * CardWidget::HEIGHT + 4 * SPACING;
+	qreal minWidth	= 9 * CardItem::WIDTH + 12 * SPACING;
+	qreal minHeight = 4 * CardItem::HEIGHT + 4 * SPACING;
 
 	mScene = new BoardScene(QRectF(QPointF(0, 0), QPointF(minWidth, minHeight)), mBoardWidget);
+	mScene->setBackgroundBrush(backgroundBrush);
+
+	// the felt and the spots are rendered once, until the view is resized
+	mBoardWidget->setCacheMode(QGraphicsView::CacheBackground);
+
 	mBoardWidget->setAlignment(Qt::AlignTop | Qt::AlignCenter);
 	mBoardWidget->setMinimumSize(minWidth, minHeight);
 	mBoardWidget->setScene(mScene);
 
-	QObject::connect(mScene, SIGNAL(rightClick()), this, SLOT(tryAutomaticAceMove()));
+	QObject::connect(mScene, SIGNAL(rightClick()), this, SLOT(autoplayAll()));
 
 	Freecell* freecell;
 	for (i = 0; i < 4; i++)
 	{
 		freecell = new Freecell(this);
-		freecell->setPosition(QPointF(i * (CardWidget::WIDTH + SPACING) + 2 * SPACING, SPACING));
+		freecell->setPosition(QPointF(i * (CardItem::WIDTH + SPACING) + 2 * SPACING, SPACING));
 		mFreeCells.push_back(freecell);
 	}
 
@@ -93,7 +105,7 @@ Board::Board()
 	for (i = 0; i < 4; i++)
 	{
 		aceSpot = new AceSpot(this, static_cast<Card::Suit>(i + 1));
-		aceSpot->setPosition(QPointF((5 + i) * (CardWidget::WIDTH + SPACING) + 2 * SPACING, SPACING));
+		aceSpot->setPosition(QPointF((5 + i) * (CardItem::WIDTH + SPACING) + 2 * SPACING, SPACING));
 		mAceSpots.push_back(aceSpot);
 	}
 
@@ -101,10 +113,11 @@ Board::Board()
 	for (i = 0; i < NB_COLUMNS; i++)
 	{
 		columnSpot = new ColumnSpot(this);
-		columnSpot->setPosition(QPointF((0.5 + i) * (CardWidget::WIDTH + SPACING) + 2 * SPACING, 2 * SPACING + CardWidget::HEIGHT));
+		columnSpot->setPosition(QPointF((0.5 + i) * (CardItem::WIDTH + SPACING) + 2 * SPACING, 2 * SPACING + CardItem::HEIGHT));
 		mColumns[i] = columnSpot;
 	}
 
+	// the 52 cards are created once, and go back to the deck between two games
 	mDeck = new Deck(this);
 
 	auto* newGameButton = new Button();
@@ -112,14 +125,14 @@ Board::Board()
 	connect(newGameButton, &Button::clicked, this, &Board::newGame);
 
 	mNewGameProxy = mScene->addWidget(newGameButton);
-	mNewGameProxy->setPos(QPointF(2.5 * SPACING + CardWidget::WIDTH / 2, mScene->height() - newGameButton->height() - SPACING));
+	mNewGameProxy->setPos(QPointF(2.5 * SPACING + CardItem::WIDTH / 2, mScene->height() - newGameButton->height() - SPACING));
 
 	auto* restartButton = new Button();
 	restartButton->setText("Restart");
 	connect(restartButton, &Button::clicked, this, &Board::restartGame);
 
 	mRestartProxy = mScene->addWidget(restartButton);
-	mRestartProxy->setPos(QPointF(3.5 * SPACING + 1.5 * CardWidget::WIDTH, mScene->height() - restartButton->height() - SPACING));
+	mRestartProxy->setPos(QPointF(3.5 * SPACING + 1.5 * CardItem::WIDTH, mScene->height() - restartButton->height() - SPACING));
 
 	mGameTimer = new QTimer;
 	mGameTimer->setInterval(1000);
@@ -129,11 +142,11 @@ Board::Board()
 	connect(mGameTimer, &QTimer::timeout, this, [=] { timerLabel->setTime(++mGameTime); });
 
 	mTimerProxy = mScene->addWidget(timerLabel);
-	mTimerProxy->setPos(QPointF(4.5 * SPACING + 2.5 * CardWidget::WIDTH, mScene->height() - restartButton->height() - SPACING));
+	mTimerProxy->setPos(QPointF(4.5 * SPACING + 2.5 * CardItem::WIDTH, mScene->height() - restartButton->height() - SPACING));
 
 	auto* gameNumberLabel = new Label();
 	gameNumberLabel->setText("Game #: 0");
-	gameNumberLabel->setFixedWidth(2 * CardWidget::WIDTH + SPACING);
+	gameNumberLabel->setFixedWidth(2 * CardItem::WIDTH + SPACING);
 
 	mGameNumberProxy = mScene->addWidget(gameNumberLabel);
 	mGameNumberProxy->setPos(QPointF(mScene->width() / 2 - gameNumberLabel->width() / 2, mScene->height() - gameNumberLabel->height() - SPACING));
@@ -144,7 +157,34 @@ Board::Board()
 	connect(undoButton, &Button::clicked, this, &Board::onUndo);
 
 	mUndoProxy = mScene->addWidget(undoButton);
-	mUndoProxy->setPos(QPointF(mScene->width() - undoButton->width() - CardWidget::WIDTH / 2 - 2 * SPACING, mScene->height() - undoButton->height() - SPACING));
+	mUndoProxy->setPos(QPointF(mScene->width() - undoButton->width() - CardItem::WIDTH / 2 - 2 * SPACING, mScene->height() - undoButton->height() - SPACING));
+
+	// scrubber over the moves of the game, between the game number and the undo button
+	auto* timelineSlider = new QSlider(Qt::Horizontal);
+	timelineSlider->setRange(0, 0);
+	timelineSlider->setFixedWidth(mUndoProxy->x() - mGameNumberProxy->x() - gameNumberLabel->width() - 2 * SPACING);
+	connect(timelineSlider, &QSlider::valueChanged, this, &Board::jumpTo);
+
+	mTimelineProxy = mScene->addWidget(timelineSlider);
+	mTimelineProxy->setPos(QPointF(mGameNumberProxy->x() + gameNumberLabel->width() + SPACING, mScene->height() - (undoButton->height() + timelineSlider->height()) / 2 - SPACING));
+
+	loadDealIndex();
+
+	// hints are searched on their own thread, and come back as queued signals
+	mHintThread = new QThread(this);
+	mHintEngine = new HintEngine();
+	mHintEngine->moveToThread(mHintThread);
+	connect(mHintThread, &QThread::finished, mHintEngine, &QObject::deleteLater);
+	connect(mHintEngine, &HintEngine::hintReady, this, &Board::onHintReady, Qt::QueuedConnection);
+	connect(mHintEngine, &HintEngine::analysisReady, this, &Board::onAnalysisReady, Qt::QueuedConnection);
+	mHintThread->start();
+}
+
+Board::~Board()
+{
+	cancelHint();
+	mHintThread->quit();
+	mHintThread->wait();
 }
 
 QWidget* Board::getBoardWidget()
@@ -152,9 +192,14 @@ QWidget* Board::getBoardWidget()
 	return mBoardWidget;
 }
 
-void Board::addItem(QGraphicsProxyWidget* proxy)
+void Board::addItem(QGraphicsItem* item)
 {
-	mScene->addItem(proxy);
+	mScene->addItem(item);
+}
+
+void Board::addSpot(CardSpotItem* spot)
+{
+	mScene->addSpot(spot);
 }
 
 void Board::dealCards(unsigned int gameNumber)
@@ -162,11 +207,10 @@ void Board::dealCards(unsigned int gameNumber)
 	Card* card;
 	int	  i = 0, col = 0;
 
-	mDeck->build(this); // NMH: TODO don't rebuild the deck unless restarting the same game
-						//	mDeck->shuffle(gameNumber);
+	mDeck->shuffle(gameNumber);
 
-	mUndoMoves.clear();
-	mRedoMoves.clear();
+	mJournal.clear();
+	mState.clear();
 
 	if (auto* label = dynamic_cast<QLabel*>(mGameNumberProxy->widget()); label)
 		label->setText(QString("Game #: %1").arg(gameNumber));
@@ -174,7 +218,7 @@ void Board::dealCards(unsigned int gameNumber)
 	while (!mDeck->empty())
 	{
 		card = mDeck->drawCard();
-		QPoint pos((i % NB_COLUMNS) * CardWidget::WIDTH, (i / NB_COLUMNS) * CardWidget::HEIGHT / 8);
+		QPoint pos((i % NB_COLUMNS) * CardItem::WIDTH, (i / NB_COLUMNS) * CardItem::HEIGHT / 8);
 		card->setPosition(pos);
 		card->setParent(mLeafColumns[col]);
 		card->setOnAceSpot(false);
@@ -185,24 +229,39 @@ void Board::dealCards(unsigned int gameNumber)
 		{
 			card->setParent(mColumns[i]);
 		}
+		mState.pushToColumn(col, card->getId());
+		mCardsById[card->getId()] = card;
+		locateCards(GameState::FIRST_COLUMN + col, mState.columnSize(col) - 1);
 		col = ++i % NB_COLUMNS;
 
 		mCards.push_back(card);
 		card->show();
-
-		connect(card, &Card::moved, this, &Board::onCardMoved, Qt::QueuedConnection);
 	}
+
+	// the deal index and the solver see the deals of fromGameNumber, "Solvable only" relies on it
+	Q_ASSERT(mState == GameState::fromGameNumber(gameNumber));
+
+	mTimeline.reset(mState);
+	updateTimeline();
+
+	QMetaObject::invokeMethod(mHintEngine, [engine = mHintEngine, state = mState] { engine->reset(state); });
 }
 
 void Board::collectCards()
 {
 	Card* card;
 
+	cancelHint();
+	unselectCard();
 	for (auto& mLeafColumn : mLeafColumns)
 	{
 		mLeafColumn = nullptr;
 	}
 
+	// the animations of the last moves belong to their group, the cards don't find them when reset
+	for (auto* group : findChildren<QParallelAnimationGroup*>())
+		group->stop();
+
 	while (!mCards.empty())
 	{
 		card = mCards.back();
@@ -212,45 +271,396 @@ void Board::collectCards()
 
 		mCards.pop_back();
 	}
+
+	mState.clear();
+	std::fill(std::begin(mLocations), std::end(mLocations), CardLocation{});
 }
 
 int Board::countFreeCells()
 {
-	int count = 0;
-	for (auto freecell : mFreeCells)
+	return mState.countFreeCells();
+}
+
+int Board::countEmptyColumns()
+{
+	return mState.countEmptyColumns();
+}
+
+bool Board::hasEnoughFreecells(int cardsToMove)
+{
+	if (mRelaxed)
+		return true;
+
+	return cardsToMove <= (countFreeCells() + 1) << countEmptyColumns();
+}
+
+/*!
+ * \brief The headless position the board is displaying
+ *
+ * The cards, spots and proxies are a view over this state: every reparenting of a card between
+ * two spots of the board is mirrored here through applyStateMove().
+ */
+const GameState& Board::state() const noexcept
+{
+	return mState;
+}
+
+/*!
+ * \brief Get the GameState slot a card holder belongs to
+ * \param holder A card spot, or a card stacked (directly or not) on a spot
+ * \return The slot, or -1 if the holder isn't on the board
+ */
+int Board::slotOf(AbstractCardHolder* holder)
+{
+	if (!holder)
+	{
+		return -1;
+	}
+
+	while (holder->getParent())
+	{
+		holder = holder->getParent();
+	}
+
+	for (int i = 0; i < NB_COLUMNS; i++)
+	{
+		if (holder == mColumns[i])
+			return GameState::FIRST_COLUMN + i;
+	}
+	for (int i = 0; i < static_cast<int>(mFreeCells.size()); i++)
+	{
+		if (holder == mFreeCells[i])
+			return GameState::FIRST_FREECELL + i;
+	}
+	for (int i = 0; i < static_cast<int>(mAceSpots.size()); i++)
+	{
+		if (holder == mAceSpots[i])
+			return GameState::FIRST_FOUNDATION + i;
+	}
+
+	return -1;
+}
+
+/*!
+ * \brief Get the spot at the bottom of a slot of the GameState, the reverse of slotOf()
+ */
+AbstractCardHolder* Board::spotOf(int slot)
+{
+	if (GameState::isColumn(slot))
+		return mColumns[slot - GameState::FIRST_COLUMN];
+	if (GameState::isFreecell(slot))
+		return mFreeCells[slot - GameState::FIRST_FREECELL];
+	return mAceSpots[slot - GameState::FIRST_FOUNDATION];
+}
+
+/*!
+ * \brief Get a card of a slot of the GameState
+ * \param slot  The slot
+ * \param index The position in the slot, 0 being the bottom
+ * \return The card, nullptr if there is none
+ */
+Card* Board::cardAt(int slot, int index) const noexcept
+{
+	if (slot < 0 || index < 0 || index >= mState.slotSize(slot))
+		return nullptr;
+
+	CardId id;
+	if (GameState::isColumn(slot))
+		id = mState.columnCard(slot - GameState::FIRST_COLUMN, index);
+	else if (GameState::isFreecell(slot))
+		id = mState.freecell(slot - GameState::FIRST_FREECELL);
+	else
+		id = cardId(slot - GameState::FIRST_FOUNDATION + 1, index + 1);
+	return mCardsById[id];
+}
+
+/*!
+ * \brief Get the slot and the position of a card in the GameState
+ */
+Board::CardLocation Board::locationOf(const Card* card) const noexcept
+{
+	return mLocations[card->getId()];
+}
+
+/*!
+ * \brief Get the number of cards stacked over a card, in constant time
+ */
+int Board::cardsAbove(const Card* card) const noexcept
+{
+	CardLocation location = locationOf(card);
+	if (location.slot < 0)
+		return 0;
+	return mState.slotSize(location.slot) - 1 - location.index;
+}
+
+/*!
+ * \brief Check if the cards stacked over a card all follow in order, as the state caches it
+ *
+ * Only columns hold unordered cards: the card must be within the ordered run on top of its
+ * column.
+ */
+bool Board::isInTopRun(const Card* card) const noexcept
+{
+	CardLocation location = locationOf(card);
+	if (!GameState::isColumn(location.slot))
+		return true;
+	return cardsAbove(card) < mState.runLength(location.slot - GameState::FIRST_COLUMN);
+}
+
+/*!
+ * \brief Get the card at the top of a slot of the GameState
+ * \return The card, nullptr if the slot is empty
+ */
+Card* Board::topCardOf(int slot)
+{
+	return cardAt(slot, mState.slotSize(slot) - 1);
+}
+
+/*!
+ * \brief Get the card at the bottom of the stack a GameState move takes
+ */
+Card* Board::movedCard(StateMove move)
+{
+	return cardAt(move.from, mState.slotSize(move.from) - move.count);
+}
+
+/*!
+ * \brief Translate the reparenting of a stack of cards into a GameState move
+ * \param from  The holder the stack comes from
+ * \param to    The holder receiving the stack
+ * \param count The number of cards in the stack
+ * \return The move, invalid if either holder isn't on the board (dealing, collecting...)
+ */
+StateMove Board::stateMove(AbstractCardHolder* from, AbstractCardHolder* to, int count)
+{
+	int fromSlot = slotOf(from);
+	int toSlot	 = slotOf(to);
+
+	if (fromSlot < 0 || toSlot < 0 || fromSlot == toSlot)
+		return {};
+
+	return {static_cast<std::uint8_t>(fromSlot), static_cast<std::uint8_t>(toSlot), static_cast<std::uint8_t>(count)};
+}
+
+/*!
+ * \brief Mirror a move of the cards in the headless state
+ * \param move The move, ignored if invalid
+ */
+void Board::applyStateMove(StateMove move)
+{
+	if (move.isValid())
+	{
+		mState.apply(move);
+		locateCards(move.to, mState.slotSize(move.to) - move.count);
+		if (mMoveDepth)
+			mPendingMoves.push_back(move);
+	}
+
+	// the incremental hash must follow every move, undo and redo of the board
+	Q_ASSERT(mState.zobristHash() == mState.computeHash(false));
+}
+
+/*!
+ * \brief Move the cards of the board as a GameState move says, without recording it
+ * \param move The move, which must be legal in the current position
+ */
+void Board::moveCards(StateMove move)
+{
+	Card* card = movedCard(move);
+	Card* top  = topCardOf(move.to);
+
+	card->blockSignals(true);
+	card->setOnAceSpot(GameState::isFoundation(move.to));
+	card->setParent(top ? static_cast<AbstractCardHolder*>(top) : spotOf(move.to), true);
+	card->blockSignals(false);
+}
+
+/*!
+ * \brief Place every card of the board where a position says, in a single repaint
+ *
+ * The cards jump to their place without animation nor signal, and the headless state is
+ * replaced by the position instead of following moves.
+ * \param state The position to display
+ */
+void Board::layoutFromState(const GameState& state)
+{
+	unselectCard();
+	mBoardWidget->setUpdatesEnabled(false);
+
+	for (auto* group : findChildren<QParallelAnimationGroup*>())
+		group->stop();
+
+	for (auto* card : mCards)
+	{
+		card->blockSignals(true);
+		for (auto* animation : card->findChildren<QPropertyAnimation*>())
+			animation->stop();
+		card->setParent(nullptr);
+	}
+
+	// the cards are detached from the board, so none of the moves below reach the state, and
+	// the cards find their place in the new one as they are stacked
+	mState = state;
+	for (int slot = 0; slot < GameState::NB_SLOTS; slot++)
+		locateCards(slot, 0);
+
+	for (int column = 0; column < NB_COLUMNS; column++)
 	{
-		if (freecell->isEmpty())
+		AbstractCardHolder* parent = mColumns[column];
+		for (int i = 0; i < state.columnSize(column); i++)
 		{
-			count++;
+			Card* card = mCardsById[state.columnCard(column, i)];
+			card->setOnAceSpot(false);
+			card->setParent(parent);
+			parent = card;
+		}
+	}
+	for (int cell = 0; cell < static_cast<int>(mFreeCells.size()); cell++)
+	{
+		if (CardId id = state.freecell(cell); id != NO_CARD)
+		{
+			mCardsById[id]->setOnAceSpot(false);
+			mCardsById[id]->setParent(mFreeCells[cell]);
 		}
 	}
+	for (int foundation = 0; foundation < static_cast<int>(mAceSpots.size()); foundation++)
+	{
+		AbstractCardHolder* parent = mAceSpots[foundation];
+		for (int value = VALUE_ACE; value <= state.foundation(foundation); value++)
+		{
+			Card* card = mCardsById[cardId(foundation + 1, value)];
+			card->setOnAceSpot(true);
+			card->setParent(parent);
+			parent = card;
+		}
+	}
+
+	for (auto* card : mCards)
+		card->blockSignals(false);
 
-	return count;
+	mBoardWidget->setUpdatesEnabled(true);
 }
 
-int Board::countEmptyColumns()
+/*!
+ * \brief Open a compound move
+ *
+ * Until the matching commitMove(), the moves of the cards only update the state: they are
+ * journaled, autoplayed and checked for victory once, at commit, and their animations run as
+ * one group. Transactions nest, only the outermost one commits.
+ */
+void Board::beginMove()
 {
-	int count = 0;
-	for (auto column : mColumns)
+	if (mMoveDepth++ == 0)
 	{
-		if (column->isEmpty())
+		mMoveStart = mState;
+		mPendingMoves.clear();
+		beginAnimations();
+	}
+}
+
+/*!
+ * \brief Close a compound move opened by beginMove()
+ *
+ * The autoplay joins the compound move, which becomes a single undo step, and movePlayed() is
+ * emitted once for all its moves.
+ */
+void Board::commitMove()
+{
+	if (--mMoveDepth > 0)
+		return;
+
+	if (!mPendingMoves.empty() && !m_victory)
+	{
+		cancelHint();
+
+		// the autoplay moves join the pending ones through applyStateMove()
+		mMoveDepth++;
+		playAutoplay(mAutoplay);
+		mMoveDepth--;
+
+		GameState state = mMoveStart;
+		for (std::size_t i = 0; i < mPendingMoves.size(); i++)
+		{
+			state.apply(mPendingMoves[i]);
+			mJournal.record(mPendingMoves[i], i > 0);
+			mTimeline.record(mJournal, state);
+			followInHintEngine(mPendingMoves[i]);
+		}
+		updateTimeline();
+
+		if (!mGameTimer->isActive())
+			mGameTimer->start();
+
+		emit movePlayed(static_cast<int>(mPendingMoves.size()));
+
+		if (checkVictory())
 		{
-			count++;
+			onVictory();
 		}
 	}
 
-	return count;
+	mPendingMoves.clear();
+	startAnimations();
 }
 
-bool Board::hasEnoughFreecells(int cardsToMove)
+/*!
+ * \brief Check if a compound move is open
+ */
+bool Board::isMoving() const noexcept
 {
-	if (mRelaxed)
-		return true;
+	return mMoveDepth > 0;
+}
+
+/*!
+ * \brief Get the group the animations of the cards should join instead of starting on their own
+ * \return The group, nullptr if the animations should start at once
+ */
+QAnimationGroup* Board::animationGroup() const noexcept
+{
+	return mAnimations;
+}
+
+/*!
+ * \brief Record where the cards of a slot lie, from a position up to the top of the slot
+ */
+void Board::locateCards(int slot, int first)
+{
+	for (int index = std::max(first, 0); index < mState.slotSize(slot); index++)
+		mLocations[cardAt(slot, index)->getId()] = {slot, index};
+}
 
-	return cardsToMove <= (countFreeCells() + 1) * (int)pow(2, countEmptyColumns());
+/*!
+ * \brief Collect the animations started from now on in a single group
+ */
+void Board::beginAnimations()
+{
+	if (!mAnimations)
+		mAnimations = new QParallelAnimationGroup(this);
+}
+
+/*!
+ * \brief Start the animations collected since beginAnimations() together
+ */
+void Board::startAnimations()
+{
+	if (mAnimations)
+	{
+		mAnimations->start(QAbstractAnimation::DeleteWhenStopped);
+		mAnimations = nullptr;
+	}
 }
 
 void Board::automaticMove(Card* card)
+{
+	beginMove();
+	moveToBestSpot(card);
+	commitMove();
+}
+
+/*!
+ * \brief Move a card to the first spot that takes it: its foundation, a column, or a freecell
+ */
+void Board::moveToBestSpot(Card* card)
 {
 	// See if it's an ACE
 	if (tryAutomaticAceMove(card))
@@ -259,15 +669,11 @@ void Board::automaticMove(Card* card)
 	}
 
 	// if not, try to move its stack to the bottom of a column
-	AbstractCardHolder* bottomSpot;
-	for (auto& mColumn : mColumns)
+	for (int column = 0; column < NB_COLUMNS; column++)
 	{
-		bottomSpot = mColumn;
-		while (bottomSpot->getChild())
-		{
-			// get the bottom card of the column
-			bottomSpot = bottomSpot->getChild();
-		}
+		AbstractCardHolder* bottomSpot = topCardOf(GameState::FIRST_COLUMN + column);
+		if (!bottomSpot)
+			bottomSpot = mColumns[column];
 		if (bottomSpot->canStackCard(card) && hasEnoughFreecells(card->countChildren()))
 		{
 			card->setParent(bottomSpot, true);
@@ -292,102 +698,120 @@ void Board::automaticMove(Card* card)
 
 bool Board::tryAutomaticAceMove(Card* card)
 {
-	if (card)
-	{
-		std::vector<AceSpot*>::iterator itAce;
-		AbstractCardHolder*				holder = nullptr;
-		for (itAce = mAceSpots.begin(); itAce < mAceSpots.end(); itAce++)
-		{
-			holder = *itAce;
-			while (holder->getChild())
-			{
-				holder = holder->getChild();
-			}
-			if (holder->canStackCard(card))
-			{
-				unselectCard();
-				selectCard(card);
-				holder->select();
-				return true;
-			}
-		}
-	}
-	else
+	for (int foundation = 0; foundation < static_cast<int>(mAceSpots.size()); foundation++)
 	{
-		for (auto& mColumn : mColumns)
+		AbstractCardHolder* holder = topCardOf(GameState::FIRST_FOUNDATION + foundation);
+		if (!holder)
+			holder = mAceSpots[foundation];
+		if (holder->canStackCard(card))
 		{
-			if (mColumn->getChild())
-			{
-				card = mColumn->getChild();
-				while (card->getChild())
-				{
-					// get the bottom card of the column
-					card = card->getChild();
-				}
-				if (tryAutomaticAceMove(card))
-				{
-					// search for another card to move
-					tryAutomaticAceMove();
-				}
-			}
+			unselectCard();
+			selectCard(card);
+			holder->select();
+			return true;
 		}
 	}
 	return false;
 }
 
-void Board::onCardMoved(Move move)
+/*!
+ * \brief Move every card that fits to the foundations, whatever the autoplay mode
+ */
+void Board::autoplayAll()
+{
+	if (m_victory)
+		return;
+
+	beginMove();
+	playAutoplay(Autoplay(Autoplay::Mode::All));
+	commitMove();
+}
+
+/*!
+ * \brief Play the moves of an autoplay on the board
+ *
+ * The whole closure is computed on the headless state first, then the cards follow. Within a
+ * compound move, the moves join it.
+ */
+void Board::playAutoplay(const Autoplay& autoplay)
 {
-	if (!m_victory)
-	{
-		mUndoMoves.push_back(move);
-		while (tryAutomaticAceMove(nullptr))
-		{
-		};
-		if (!mGameTimer->isActive())
-			mGameTimer->start();
+	std::vector<StateMove> moves;
+	GameState			   state = mState;
+	autoplay.run(state, moves);
 
-		if (checkVictory())
-		{
-			onVictory();
-		}
-	}
+	for (auto move : moves)
+		moveCards(move);
 }
 
 void Board::onUndo()
 {
-	if (!mUndoMoves.empty())
+	if (mJournal.canUndo())
 	{
-		auto move = mUndoMoves.back();
-		mUndoMoves.pop_back();
+		cancelHint();
+		beginAnimations();
 
-		if (auto card = move.card(); card)
+		// the moves of a compound move go back together
+		bool linked;
+		do
 		{
-			card->blockSignals(true);
-			card->setOnAceSpot(false);
-			card->setParent(move.previousParent(), true);
-			card->blockSignals(false);
-
-			mRedoMoves.push_back(move);
-		}
+			linked	  = mJournal.isLinked(mJournal.position() - 1);
+			auto move = mJournal.undo().reversed();
+			moveCards(move);
+			followInHintEngine(move);
+		} while (linked && mJournal.canUndo());
+
+		startAnimations();
+		updateTimeline();
 	}
 }
 
 void Board::onRedo()
 {
-	if (!mRedoMoves.empty())
+	if (mJournal.canRedo())
 	{
-		auto move = mRedoMoves.back();
-		mRedoMoves.pop_back();
+		cancelHint();
+		beginAnimations();
 
-		if (auto card = move.card(); card)
+		do
 		{
-			card->blockSignals(true);
-			card->setOnAceSpot(false);
-			card->setParent(move.parent(), true);
-			card->blockSignals(false);
+			auto move = mJournal.redo();
+			moveCards(move);
+			followInHintEngine(move);
+		} while (mJournal.canRedo() && mJournal.isLinked(mJournal.position()));
 
-			mUndoMoves.push_back(move);
-		}
+		startAnimations();
+		updateTimeline();
+	}
+}
+
+/*!
+ * \brief Show the game as it was after some moves of the journal
+ *
+ * The position is rebuilt from the nearest keyframe of the timeline, and displayed at once
+ * rather than by animating every move in between.
+ * \param position The number of moves played, from 0 to the size of the journal
+ */
+void Board::jumpTo(int position)
+{
+	if (m_victory || position < 0 || static_cast<std::size_t>(position) == mJournal.position())
+		return;
+
+	cancelHint();
+	layoutFromState(mTimeline.stateAt(mJournal, static_cast<std::size_t>(position)));
+	mJournal.seek(static_cast<std::size_t>(position));
+	updateTimeline();
+}
+
+/*!
+ * \brief Make the timeline scrubber reflect the journal
+ */
+void Board::updateTimeline()
+{
+	if (auto* slider = dynamic_cast<QSlider*>(mTimelineProxy->widget()); slider)
+	{
+		QSignalBlocker blocker(slider);
+		slider->setRange(0, static_cast<int>(mJournal.size()));
+		slider->setValue(static_cast<int>(mJournal.position()));
 	}
 }
 
@@ -412,7 +836,9 @@ void Board::selectCard(Card* card)
 		{
 			mSelectedCard->setOnAceSpot(true);
 		}
+		beginMove();
 		mSelectedCard->setParent(card, true);
+		commitMove();
 	}
 	else
 	{
@@ -437,6 +863,11 @@ Card* Board::getSelectedCard()
 	return mSelectedCard;
 }
 
+void Board::setAutoplayMode(Autoplay::Mode mode)
+{
+	mAutoplay.setMode(mode);
+}
+
 void Board::setRelaxed(bool value)
 {
 	mRelaxed = value;
@@ -447,6 +878,64 @@ bool Board::isRelaxed() const noexcept
 	return mRelaxed;
 }
 
+/*!
+ * \brief Check if a deal index was found, which is required to only deal solvable games
+ */
+bool Board::hasDealIndex() const noexcept
+{
+	return mDealIndex.isValid();
+}
+
+/*!
+ * \brief Only deal games known to be solvable, within the difficulty range, on new games
+ */
+void Board::setSolvableOnly(bool value)
+{
+	mSolvableOnly = value;
+}
+
+/*!
+ * \brief Set the difficulty range of new games, when only solvable games are dealt
+ */
+void Board::setDifficultyRange(int minDifficulty, int maxDifficulty)
+{
+	mMinDifficulty = minDifficulty;
+	mMaxDifficulty = maxDifficulty;
+}
+
+/*!
+ * \brief Map the deal index written by freecell-dealscan, if any
+ *
+ * The file is looked for as `deals.idx` next to the executable, then in the application data
+ * directory. It is memory-mapped rather than read, so that opening it costs the same whatever
+ * its size, and only the pages of the sampled entries are ever loaded.
+ */
+void Board::loadDealIndex()
+{
+	const QStringList paths = {QCoreApplication::applicationDirPath() + "/deals.idx",
+							   QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/deals.idx"};
+
+	for (const auto& path : paths)
+	{
+		mDealIndexFile.setFileName(path);
+		if (!mDealIndexFile.open(QIODevice::ReadOnly))
+		{
+			continue;
+		}
+
+		const uchar* data = mDealIndexFile.map(0, mDealIndexFile.size());
+		mDealIndex		  = DealIndex(data, data ? mDealIndexFile.size() : 0);
+		if (mDealIndex.isValid())
+		{
+			qInfo("Deal index %s: games #%u to #%u", qPrintable(path), mDealIndex.firstGame(), mDealIndex.firstGame() + mDealIndex.count() - 1);
+			return;
+		}
+
+		qWarning("Ignoring deal index %s: not an index of the current deal generator", qPrintable(path));
+		mDealIndexFile.close();
+	}
+}
+
 /*!
  * \brief Start a new game
  */
@@ -458,9 +947,18 @@ void Board::newGame()
 	endGame();
 
 	// generate random game number
-	std::random_device							randomDevice;
-	std::uniform_int_distribution<unsigned int> gameNumberDistribution(1'000'000, 9'999'999);
-	mGameNumber = gameNumberDistribution(randomDevice);
+	std::random_device randomDevice;
+	mGameNumber = 0;
+	if (mSolvableOnly && mDealIndex.isValid())
+	{
+		std::mt19937 generator(randomDevice());
+		mGameNumber = mDealIndex.sample(generator, mMinDifficulty, mMaxDifficulty);
+	}
+	if (mGameNumber == 0)
+	{
+		std::uniform_int_distribution<unsigned int> gameNumberDistribution(1'000'000, 9'999'999);
+		mGameNumber = gameNumberDistribution(randomDevice);
+	}
 
 	// deal the cards
 	this->dealCards(mGameNumber);
@@ -470,11 +968,13 @@ void Board::newGame()
 
 /**
  * Select a specific game number to play
+ *
+ * Numbers below 1,000,000 are the games of the original Microsoft Freecell.
  */
 void Board::selectGame()
 {
 	bool ok		= false;
-	mGameNumber = QInputDialog::getInt(mBoardWidget, "Select Game #", "Game #:", mGameNumber, 1'000'000, 9'999'999, 1, &ok);
+	mGameNumber = QInputDialog::getInt(mBoardWidget, "Select Game #", "Game #:", mGameNumber, 1, 9'999'999, 1, &ok);
 	if (ok)
 	{
 		QGuiApplication::setOverrideCursor(Qt::WaitCursor);
@@ -514,18 +1014,122 @@ void Board::resetGameTime()
 
 bool Board::checkVictory() const
 {
-	for (auto* card : mCards)
-		if (!card->isOnAceSpot())
-			return false;
+	return mState.isWon();
+}
+
+/*!
+ * \brief Tell the player whether the current position can still be won, without blocking the board
+ *
+ * The search runs on the hint thread from a copy of the position, like the hints. It's cancelled
+ * by the next move of the board, and its result is shown by onAnalysisReady().
+ */
+void Board::checkWinnable()
+{
+	mAnalysisStop.request_stop();
+	mAnalysisStop = std::stop_source();
+
+	QMetaObject::invokeMethod(mHintEngine, [engine = mHintEngine, state = mState, stopToken = mAnalysisStop.get_token(), request = ++mAnalysisRequest]
+							  { engine->analyze(state, stopToken, request); });
+}
+
+/*!
+ * \brief Show whether the position of a winnability check can be won
+ * \param request The request the result belongs to, ignored unless it's the last one
+ * \param result  The outcome of the search
+ * \param moves   The number of moves of the solution found
+ */
+void Board::onAnalysisReady(quint64 request, Solver::Result result, int moves)
+{
+	if (request != mAnalysisRequest || mAnalysisStop.stop_requested())
+		return;
+
+	QString text;
+	switch (result)
+	{
+		case Solver::Result::Solved:
+			text = QString("This game can be won in %1 moves.").arg(moves);
+			break;
+		case Solver::Result::Unsolvable:
+			text = "This game can't be won from here.";
+			break;
+		default:
+			text = QString("Couldn't tell whether this game can be won (%1).").arg(Solver::resultName(result));
+			break;
+	}
+	QMessageBox::information(mBoardWidget, "Is This Game Winnable?", text);
+}
+
+/*!
+ * \brief Search the next move to play from the current position, without blocking the board
+ *
+ * The search runs on the hint thread from a copy of the position. It's cancelled by the next
+ * move of the board, and its result is shown by onHintReady().
+ */
+void Board::showHint()
+{
+	if (m_victory)
+		return;
+
+	mHintStop.request_stop();
+	mHintStop = std::stop_source();
+	mHintClock.start();
+
+	QMetaObject::invokeMethod(mHintEngine, [engine = mHintEngine, state = mState, stopToken = mHintStop.get_token(), request = ++mHintRequest]
+							  { engine->search(state, stopToken, request); });
+}
+
+/*!
+ * \brief Tell the hint engine about a move of the board, after the searches already queued
+ */
+void Board::followInHintEngine(StateMove move)
+{
+	QMetaObject::invokeMethod(mHintEngine, [engine = mHintEngine, move] { engine->play(move); });
+}
+
+/*!
+ * \brief Stop the hint search and the winnability check in progress, if any
+ */
+void Board::cancelHint()
+{
+	mHintStop.request_stop();
+	mAnalysisStop.request_stop();
+}
+
+/*!
+ * \brief Highlight the card a hint search says to move
+ * \param request The request the result belongs to, ignored unless it's the last one
+ * \param move    The move to play, invalid if no winning move was found
+ * \param result  The outcome of the search
+ * \param seconds The time spent searching on the hint thread
+ */
+void Board::onHintReady(quint64 request, StateMove move, Solver::Result result, double seconds)
+{
+	if (request != mHintRequest || mHintStop.stop_requested())
+		return;
+
+	if (!move.isValid())
+	{
+		QMessageBox::information(mBoardWidget, "Hint", QString("No winning move found (%1).").arg(Solver::resultName(result)));
+		return;
+	}
 
-	return true;
+	unselectCard();
+	setSelectedCard(movedCard(move));
+	qInfo("Hint: %d card(s) from slot %d to slot %d, highlighted %.1f ms after the request (%.1f ms searching)", move.count, move.from, move.to,
+		  mHintClock.nsecsElapsed() / 1e6, seconds * 1000.0);
 }
 
 void Board::onVictory()
 {
 	mGameTimer->stop();
 	m_victory = true;
-	QTimer::singleShot(1000, this, &Board::victoryAnimation);
+	QTimer::singleShot(1000, this,
+					   [this]
+					   {
+						   // the player may have started another game meanwhile
+						   if (m_victory)
+							   victoryAnimation();
+					   });
 }
 
 void Board::victoryAnimation()
@@ -539,21 +1143,22 @@ void Board::victoryAnimation()
 	int time = 15;
 	for (auto* card : mCards)
 	{
-		int x	  = -CardWidget::WIDTH;
-		int y	  = -CardWidget::HEIGHT;
+		int x	  = -CardItem::WIDTH;
+		int y	  = -CardItem::HEIGHT;
 		int angle = distAngle(generator);
 
-		while (x < -CardWidget::WIDTH / 2 || x > (mScene->width() + CardWidget::WIDTH / 2))
+		while (x < -CardItem::WIDTH / 2 || x > (mScene->width() + CardItem::WIDTH / 2))
 			x = distX(generator);
 
-		while (y < -CardWidget::HEIGHT / 2 || y > (mScene->height() - 1.5 * CardWidget::HEIGHT))
+		while (y < -CardItem::HEIGHT / 2 || y > (mScene->height() - 1.5 * CardItem::HEIGHT))
 			y = distY(generator);
 
 		time += 15;
 		QTimer::singleShot(time, this,
 						   [=]
 						   {
-							   card->scatter({x,y}, angle);
+							   if (m_victory)
+								   card->scatter({x,y}, angle);
 						   });
 	}
 }
\ No newline at end of file
@@ -18,21 +18,34 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <QElapsedTimer>
+#include <QFile>
 #include <QObject>
-#include <deque>
+#include <stop_token>
 #include <vector>
 
+#include "autoplay.h"
 #include "card.h"
+#include "dealindex.h"
 #include "deck.h"
+#include "gamestate.h"
+#include "hintengine.h"
+#include "movejournal.h"
+#include "timeline.h"
 
+class QAnimationGroup;
+class QGraphicsItem;
 class QGraphicsProxyWidget;
 class QGraphicsView;
+class QParallelAnimationGroup;
+class QThread;
 class QWidget;
 
 class AceSpot;
 class ColumnSpot;
 class Freecell;
 class BoardScene;
+class CardSpotItem;
 
 class Board : public QObject
 {
@@ -41,9 +54,19 @@ public:
 
 	static constexpr int SPACING = 15;
 
+	/*!
+	 * \brief Where a card lies in the headless state
+	 */
+	struct CardLocation
+	{
+		int slot  = -1; //!< The GameState slot, -1 if the card isn't on the board
+		int index = 0;	//!< The position of the card in the slot, 0 being the bottom
+	};
+
 public:
 
 	Board();
+	~Board() override;
 
 	void dealCards(unsigned int gameNumber);
 	void collectCards();
@@ -52,17 +75,42 @@ public:
 	int	 countEmptyColumns();
 	bool hasEnoughFreecells(int cardsToMove);
 
+	const GameState&	state() const noexcept;
+	int					slotOf(AbstractCardHolder* holder);
+	AbstractCardHolder* spotOf(int slot);
+	Card*				cardAt(int slot, int index) const noexcept;
+	CardLocation		locationOf(const Card* card) const noexcept;
+	int					cardsAbove(const Card* card) const noexcept;
+	bool				isInTopRun(const Card* card) const noexcept;
+	Card*				topCardOf(int slot);
+	Card*				movedCard(StateMove move);
+	StateMove			stateMove(AbstractCardHolder* from, AbstractCardHolder* to, int count);
+	void				applyStateMove(StateMove move);
+	void				moveCards(StateMove move);
+	void				layoutFromState(const GameState& state);
+
+	void			 beginMove();
+	void			 commitMove();
+	bool			 isMoving() const noexcept;
+	QAnimationGroup* animationGroup() const noexcept;
+
 	void automaticMove(Card*);
 	void unselectCard();
 	void selectCard(Card*);
 
 	void  setSelectedCard(Card*);
 	Card* getSelectedCard();
-	void  addItem(QGraphicsProxyWidget*);
+	void  addItem(QGraphicsItem*);
+	void  addSpot(CardSpotItem*);
 
+	void setAutoplayMode(Autoplay::Mode mode);
 	void setRelaxed(bool value);
 	bool isRelaxed() const noexcept;
 
+	bool hasDealIndex() const noexcept;
+	void setSolvableOnly(bool value);
+	void setDifficultyRange(int minDifficulty, int maxDifficulty);
+
 	QWidget* getBoardWidget();
 
 public slots:
@@ -75,16 +123,38 @@ public slots:
 	void resetGameTime();
 
 	bool checkVictory() const;
-	bool tryAutomaticAceMove(Card* card = nullptr);
+	void checkWinnable();
+	void showHint();
+	void cancelHint();
+	bool tryAutomaticAceMove(Card* card);
+	void autoplayAll();
 
-	void onCardMoved(Move move);
 	void onUndo();
 	void onRedo();
+	void jumpTo(int position);
+	void onHintReady(quint64 request, StateMove move, Solver::Result result, double seconds);
+	void onAnalysisReady(quint64 request, Solver::Result result, int moves);
 	void onVictory();
 
+signals:
+
+	/*!
+	 * \brief A compound move was committed
+	 * \param moveCount The number of moves it made, autoplay included
+	 */
+	void movePlayed(int moveCount);
+
 protected:
 
 	void victoryAnimation();
+	void loadDealIndex();
+	void updateTimeline();
+	void followInHintEngine(StateMove move);
+	void playAutoplay(const Autoplay& autoplay);
+	void moveToBestSpot(Card* card);
+	void beginAnimations();
+	void startAnimations();
+	void locateCards(int slot, int first);
 
 protected:
 
@@ -102,8 +172,33 @@ protected:
 	Card*			   mSelectedCard;
 	std::vector<Card*> mCards;
 
-	std::deque<Move> mUndoMoves;
-	std::deque<Move> mRedoMoves;
+	// the columns are the ones of the state, these tables only link its card ids and the cards
+	GameState	 mState;
+	Card*		 mCardsById[NB_CARDS] = {};
+	CardLocation mLocations[NB_CARDS];
+
+	QFile	  mDealIndexFile;
+	DealIndex mDealIndex;
+	bool	  mSolvableOnly	 = false;
+	int		  mMinDifficulty = DealIndex::MIN_DIFFICULTY;
+	int		  mMaxDifficulty = DealIndex::MAX_DIFFICULTY;
+
+	MoveJournal mJournal;
+	Timeline	mTimeline;
+	Autoplay	mAutoplay;
+
+	int						 mMoveDepth = 0;
+	GameState				 mMoveStart;
+	std::vector<StateMove>	 mPendingMoves;
+	QParallelAnimationGroup* mAnimations = nullptr;
+
+	QThread*		 mHintThread = nullptr;
+	HintEngine*		 mHintEngine = nullptr;
+	std::stop_source mHintStop;
+	quint64			 mHintRequest = 0;
+	QElapsedTimer	 mHintClock;
+	std::stop_source mAnalysisStop;
+	quint64			 mAnalysisRequest = 0;
 
 	QTimer* mGameTimer = nullptr;
 	int		mGameTime  = 0;
@@ -113,6 +208,7 @@ protected:
 	QGraphicsProxyWidget* mTimerProxy	   = nullptr;
 	QGraphicsProxyWidget* mGameNumberProxy = nullptr;
 	QGraphicsProxyWidget* mUndoProxy	   = nullptr;
+	QGraphicsProxyWidget* mTimelineProxy   = nullptr;
 
 	bool		 m_victory	 = false;
 	bool		 mRelaxed	 = false;
@@ -16,10 +16,24 @@
  */
 
 #include "boardscene.h"
+#include "cardspotitem.h"
 #include <QGraphicsSceneMouseEvent>
+#include <QPainter>
 
 BoardScene::BoardScene(const QRectF sceneRect, QObject* parent) : QGraphicsScene(sceneRect, parent)
 {
+    // the cards move all the time, an index would be rebuilt at each step of their animations
+    setItemIndexMethod(NoIndex);
+}
+
+/*!
+ * \brief Add a spot, which is drawn with the background
+ */
+void BoardScene::addSpot(CardSpotItem* spot)
+{
+    addItem(spot);
+    mSpots.push_back(spot);
+    invalidate(QRectF(), BackgroundLayer);
 }
 
 void BoardScene::mousePressEvent(QGraphicsSceneMouseEvent* event)
@@ -29,3 +43,22 @@ void BoardScene::mousePressEvent(QGraphicsSceneMouseEvent* event)
         emit rightClick();
     }
 }
+
+/*!
+ * \brief Draw the felt, then the decoration of the spots
+ */
+void BoardScene::drawBackground(QPainter* painter, const QRectF& rect)
+{
+    QGraphicsScene::drawBackground(painter, rect);
+
+    for (auto* spot : mSpots)
+    {
+        if (!spot->sceneBoundingRect().intersects(rect))
+            continue;
+
+        painter->save();
+        painter->translate(spot->pos());
+        spot->paintDecoration(painter);
+        painter->restore();
+    }
+}
@@ -19,17 +19,31 @@
 #define BOARDSCENE_H
 
 #include <QGraphicsScene>
+#include <vector>
 
+class CardSpotItem;
+
+/*!
+ * \brief The scene of the board
+ *
+ * The felt and the spots never change: they are drawn as the background, which the view caches,
+ * so that only the moving cards are painted during a move.
+ */
 class BoardScene : public QGraphicsScene
 {
     Q_OBJECT
 public:
     BoardScene(const QRectF sceneRect, QObject* parent = 0);
 
+    void addSpot(CardSpotItem* spot);
+
 signals:
     void rightClick();
 protected:
     void mousePressEvent(QGraphicsSceneMouseEvent *event);
+    void drawBackground(QPainter* painter, const QRectF& rect) override;
+
+    std::vector<CardSpotItem*> mSpots;
 };
 
 #endif // BOARDSCENE_H
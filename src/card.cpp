@@ -17,9 +17,10 @@
 
 #include "card.h"
 #include "board.h"
-#include "cardproxy.h"
-#include "cardwidget.h"
+#include "carditem.h"
+#include "rules.h"
 
+#include <QAnimationGroup>
 #include <QPropertyAnimation>
 
 #include <QMetaEnum>
@@ -41,18 +42,13 @@ Card::Card(Suit suit, Value value, Board* board)
 	m_board		  = board;
 	m_isOnAceSpot = false;
 
-	m_widget = new CardWidget();
-	m_widget->setCard(value, suit);
-	setSelected(false);
-
-	m_proxy = new CardProxy(this);
-	m_proxy->setWidget(m_widget);
-	m_board->addItem(m_proxy);
+	m_item = new CardItem(this);
+	m_board->addItem(m_item);
 }
 
 Card::~Card()
 {
-	delete m_widget;
+	delete m_item;
 }
 
 /*!
@@ -73,6 +69,7 @@ void Card::setParent(AbstractCardHolder* parent, bool animate)
 {
 	auto newParent = parent;
 	auto oldParent = m_parent;
+	auto stateMove = m_board->stateMove(oldParent, newParent, countChildren() + 1);
 
 	if (m_parent)
 	{
@@ -81,17 +78,18 @@ void Card::setParent(AbstractCardHolder* parent, bool animate)
 
 	m_parent = parent;
 
+	// the stacking queries read the state, which must follow before the cards are laid out
+	if(oldParent != newParent)
+	{
+		m_board->applyStateMove(stateMove);
+	}
+
 	if (m_parent)
 	{
 		m_parent->setChild(this);
 		updatePosition(animate);
 		m_board->unselectCard();
 	}
-
-	if(oldParent != newParent)
-	{
-		emit this->moved({this, newParent, oldParent});
-	}
 }
 
 /*!
@@ -100,11 +98,7 @@ void Card::setParent(AbstractCardHolder* parent, bool animate)
  */
 int Card::countChildren()
 {
-	if (!m_child)
-	{
-		return 0;
-	}
-	return m_child->countChildren() + 1;
+	return m_board->cardsAbove(this);
 }
 
 /*!
@@ -143,7 +137,7 @@ bool Card::isMovable()
 	{
 		return true;
 	}
-	return isValidParentOf(m_child) && m_child->isMovable() && m_board->hasEnoughFreecells(countChildren() + 1);
+	return m_board->isInTopRun(this) && m_board->hasEnoughFreecells(countChildren() + 1);
 }
 
 /*!
@@ -159,9 +153,9 @@ bool Card::isValidParentOf(Card* card)
 	}
 	if (m_isOnAceSpot)
 	{
-		return getValue() - card->getValue() == -1 && card->getSuit() == getSuit();
+		return canStackOnFoundation(getId(), card->getId());
 	}
-	return this->getValue() - card->getValue() == 1 && card->getBlackRedColor() != this->getBlackRedColor();
+	return canStackOnTableau(getId(), card->getId());
 }
 
 bool Card::isValidParentOfAllChildren()
@@ -169,7 +163,7 @@ bool Card::isValidParentOfAllChildren()
 	if(!m_child)
 		return true;
 
-	return isValidParentOf(m_child) && m_child->isValidParentOfAllChildren();
+	return m_board->isInTopRun(this);
 }
 
 /*!
@@ -243,6 +237,15 @@ Card::Suit Card::getSuit()
 	return m_suit;
 }
 
+/*!
+ * \brief Get the identity of the card, as used by the headless GameState
+ * \return CardId
+ */
+CardId Card::getId() const noexcept
+{
+	return cardId(m_suit, m_value);
+}
+
 /*!
  * \brief Convert the color of the card to the "real" (red or black) color
  * \return 1 or 2
@@ -263,7 +266,7 @@ QPoint Card::getChildPosition()
 	int	   y   = pos.y();
 	if (!m_isOnAceSpot)
 	{
-		y += +CardWidget::HEIGHT / 6;
+		y += +CardItem::HEIGHT / 6;
 	}
 
 	return {x, y};
@@ -283,11 +286,14 @@ void Card::animatePosition(QPoint pos)
 	m_position = pos;
 	setZIndex(100);
 
-	QPropertyAnimation* animation = new QPropertyAnimation(m_widget, "pos");
+	QPropertyAnimation* animation = new QPropertyAnimation(m_item, "pos", this);
 	animation->setDuration(100);
-	animation->setStartValue(m_widget->pos());
-	animation->setEndValue(m_position);
-	animation->start(QAbstractAnimation::DeleteWhenStopped);
+	animation->setStartValue(m_item->pos());
+	animation->setEndValue(QPointF(m_position));
+	if (auto* group = m_board->animationGroup())
+		group->addAnimation(animation);
+	else
+		animation->start(QAbstractAnimation::DeleteWhenStopped);
 
 	QObject::connect(animation, SIGNAL(finished()), this, SLOT(resetZIndex()), Qt::QueuedConnection);
 
@@ -299,7 +305,7 @@ void Card::animatePosition(QPoint pos)
 
 void Card::animateRotation(int angle)
 {
-	QPropertyAnimation* animation = new QPropertyAnimation(m_proxy, "rotation");
+	QPropertyAnimation* animation = new QPropertyAnimation(m_item, "rotation", this);
 	animation->setDuration(100);
 	animation->setStartValue(0);
 	animation->setEndValue(angle);
@@ -313,7 +319,7 @@ void Card::animateRotation(int angle)
 void Card::setPosition(QPoint pos)
 {
 	m_position = pos;
-	m_widget->move(m_position);
+	m_item->setPos(m_position);
 	if (m_child)
 	{
 		m_child->updatePosition();
@@ -347,11 +353,9 @@ void Card::updatePosition(bool animate)
  */
 int Card::getTopZIndex()
 {
-	if (m_child)
-	{
-		return m_child->getTopZIndex();
-	}
-	return getZIndex() + 1;
+	auto  location = m_board->locationOf(this);
+	Card* top	   = m_child ? m_board->cardAt(location.slot, location.index + countChildren()) : nullptr;
+	return (top ? top : this)->getZIndex() + 1;
 }
 
 /*!
@@ -360,7 +364,7 @@ int Card::getTopZIndex()
  */
 int Card::getZIndex()
 {
-	return m_proxy->zValue();
+	return m_item->zValue();
 }
 
 /*!
@@ -370,11 +374,18 @@ int Card::getZIndex()
  */
 void Card::setZIndex(int index, bool cascade)
 {
+	m_item->setZValue(index);
 	if (m_child && cascade)
 	{
-		m_child->setZIndex(index + 1);
+		auto location = m_board->locationOf(this);
+		for (int i = 1, count = countChildren(); i <= count; i++)
+		{
+			if (Card* card = m_board->cardAt(location.slot, location.index + i))
+			{
+				card->m_item->setZValue(index + i);
+			}
+		}
 	}
-	m_proxy->setZValue(index);
 }
 
 void Card::resetZIndex()
@@ -391,7 +402,7 @@ void Card::resetZIndex()
  */
 void Card::show()
 {
-	m_widget->show();
+	m_item->show();
 }
 
 /*!
@@ -399,7 +410,7 @@ void Card::show()
  */
 void Card::hide()
 {
-	m_widget->hide();
+	m_item->hide();
 }
 
 void Card::select()
@@ -414,7 +425,7 @@ void Card::select()
  */
 void Card::setSelected(bool selected)
 {
-	m_widget->setSelected(selected);
+	m_isSelected = selected;
 }
 
 /*!
@@ -423,7 +434,7 @@ void Card::setSelected(bool selected)
  */
 bool Card::isSelected()
 {
-	return m_widget->selected();
+	return m_isSelected;
 }
 
 /*!
@@ -435,9 +446,9 @@ void Card::automaticMove()
 	m_board->automaticMove(this);
 }
 
-CardProxy* Card::proxy()
+CardItem* Card::item()
 {
-	return m_proxy;
+	return m_item;
 }
 
 void Card::scatter(QPoint point, int angle)
@@ -454,4 +465,20 @@ void Card::scatter(QPoint point, int angle)
 void Card::setScattered(bool scattered)
 {
 	m_isScattered = scattered;
+}
+
+/*!
+ * \brief Bring the card back to its initial look, so that it can be dealt again
+ */
+void Card::reset()
+{
+	// animations of the last game would otherwise move the card once dealt
+	for (auto* animation : findChildren<QPropertyAnimation*>())
+	{
+		animation->stop();
+	}
+	m_item->setRotation(0);
+	setSelected(false);
+	m_isOnAceSpot = false;
+	m_isScattered = false;
 }
\ No newline at end of file
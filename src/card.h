@@ -22,10 +22,9 @@
 #include <QPoint>
 
 #include "abstractcardholder.h"
-#include "move.h"
+#include "cardid.h"
 
-class CardWidget;
-class CardProxy;
+class CardItem;
 class Board;
 
 /*!
@@ -81,9 +80,10 @@ public:
 	QString getSuitName();
 	QString getLabel();
 
-	Value getValue();
-	Suit  getSuit();
-	char  getBlackRedColor();
+	Value  getValue();
+	Suit   getSuit();
+	CardId getId() const noexcept;
+	char   getBlackRedColor();
 
 	QPoint getPosition();
 	QPoint getChildPosition() override;
@@ -101,12 +101,10 @@ public:
 	bool isSelected();
 	void setSelected(bool selected);
 	void setScattered(bool scattered);
+	void reset();
 	void automaticMove();
 
-	CardProxy* proxy();
-
-signals:
-	void moved(Move move);
+	CardItem* item();
 
 public slots:
 	void resetZIndex();
@@ -119,12 +117,12 @@ protected:
 
 	QPoint m_position;
 
-	Board*		m_board = nullptr;
-	CardWidget* m_widget = nullptr;
-	CardProxy*	m_proxy = nullptr;
+	Board*	  m_board = nullptr;
+	CardItem* m_item  = nullptr;
 
 	bool m_isOnAceSpot = false;
 	bool m_isScattered = false;
+	bool m_isSelected  = false;
 };
 
 inline Card::Value& operator++(Card::Value& value)
@@ -0,0 +1,160 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cardatlas.h"
+
+#include <QDirIterator>
+#include <QPainter>
+#include <QResource>
+
+#include <algorithm>
+
+/*!
+ * \brief Get the atlas shared by all the cards, creating it on the first call
+ */
+CardAtlas& CardAtlas::instance()
+{
+	static CardAtlas atlas;
+	return atlas;
+}
+
+/*!
+ * \brief Constructor, maps the sheets built with the game
+ */
+CardAtlas::CardAtlas()
+{
+	QDirIterator it(":/sprites");
+	while (it.hasNext())
+	{
+		// the sheets are bundled uncompressed, their pixels are used where they lie
+		QResource resource(it.next());
+		if (resource.compressionAlgorithm() != QResource::NoCompression)
+		{
+			qWarning("The sprite sheet %s is compressed.", qPrintable(resource.fileName()));
+			continue;
+		}
+
+		QImage image = SpriteSheet::load(resource.data(), resource.size());
+		if (image.isNull())
+		{
+			qWarning("Invalid sprite sheet %s.", qPrintable(resource.fileName()));
+			continue;
+		}
+
+		Sheet& loaded	= m_sheets.emplace_back();
+		loaded.tileSize = {image.width() / SpriteSheet::NB_COLUMNS, image.height() / SpriteSheet::NB_ROWS};
+		loaded.image	= image;
+		loaded.prebuilt = true;
+		loaded.rendered.set();
+	}
+
+	if (m_sheets.empty())
+	{
+		qWarning("No sprite sheet for the cards.");
+	}
+}
+
+/*!
+ * \brief Get the tile of a card face in the atlas
+ */
+int CardAtlas::faceTile(Card::Value value, Card::Suit suit) noexcept
+{
+	return SpriteSheet::faceTile(value, suit);
+}
+
+/*!
+ * \brief Get the tile of the card back in the atlas
+ */
+int CardAtlas::backTile() noexcept
+{
+	return SpriteSheet::BACK_TILE;
+}
+
+/*!
+ * \brief Draw a tile with a single copy from the sheet of the size it has on the device
+ * \param painter The painter, its device pixel ratio is part of the size
+ * \param target  The rectangle of the card, in the painter's coordinates
+ * \param tile    The tile to draw
+ * \param scale   The scale from the painter's coordinates to the device independent pixels
+ */
+void CardAtlas::draw(QPainter* painter, const QRectF& target, int tile, qreal scale)
+{
+	Sheet& drawn = sheet(qRound(target.width() * scale * painter->device()->devicePixelRatio()));
+	if (!drawn.rendered[tile])
+		renderTile(drawn, tile);
+
+	painter->drawImage(target, drawn.image, SpriteSheet::tileRect(drawn.tileSize, tile));
+}
+
+/*!
+ * \brief Get the sheet of a tile width, replacing the oldest scaled sheet when there are too many
+ */
+CardAtlas::Sheet& CardAtlas::sheet(int width)
+{
+	width	= std::max(width, 1);
+	auto it = std::find_if(m_sheets.begin(), m_sheets.end(), [width](const Sheet& sheet) { return sheet.tileSize.width() == width; });
+	if (it != m_sheets.end())
+		return *it;
+
+	auto scaled = std::count_if(m_sheets.begin(), m_sheets.end(), [](const Sheet& sheet) { return !sheet.prebuilt; });
+	if (scaled >= MAX_SHEETS)
+		m_sheets.erase(std::find_if(m_sheets.begin(), m_sheets.end(), [](const Sheet& sheet) { return !sheet.prebuilt; }));
+
+	Sheet& added   = m_sheets.emplace_back();
+	added.tileSize = SpriteSheet::tileSize(width);
+	added.image	   = QImage(added.tileSize.width() * SpriteSheet::NB_COLUMNS, added.tileSize.height() * SpriteSheet::NB_ROWS, QImage::Format_ARGB32_Premultiplied);
+	added.image.fill(Qt::transparent);
+	return added;
+}
+
+/*!
+ * \brief Render a tile of a scaled sheet
+ *
+ * The tile is scaled down from the smallest sheet built with the game that is larger. A prebuilt
+ * sheet is never scaled up: larger tiles are rendered from the card images, as freecell-atlas
+ * does.
+ */
+void CardAtlas::renderTile(Sheet& sheet, int tile)
+{
+	sheet.rendered[tile] = true;
+
+	const Sheet* source = nullptr;
+	for (const auto& candidate : m_sheets)
+	{
+		if (candidate.prebuilt && candidate.tileSize.width() > sheet.tileSize.width()
+			&& (!source || candidate.tileSize.width() < source->tileSize.width()))
+			source = &candidate;
+	}
+
+	QPainter painter(&sheet.image);
+	QRect	 target = SpriteSheet::tileRect(sheet.tileSize, tile);
+	if (source)
+	{
+		painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+		painter.setCompositionMode(QPainter::CompositionMode_Source);
+		painter.drawImage(target, source->image, SpriteSheet::tileRect(source->tileSize, tile));
+		return;
+	}
+
+	if (m_paper.isNull())
+		m_paper = QImage(":/images/card");
+
+	QImage face(":/cards/" + SpriteSheet::imageName(tile));
+	if (face.isNull())
+		qWarning("Failed to load card image %s.", qPrintable(SpriteSheet::imageName(tile)));
+	SpriteSheet::renderTile(painter, target, m_paper, face);
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CARDATLAS_H
+#define CARDATLAS_H
+
+#include <QImage>
+#include <QRect>
+
+#include <bitset>
+#include <vector>
+
+#include "card.h"
+#include "spritesheet.h"
+
+class QPainter;
+
+/*!
+ * \brief All the card faces and the back, in sprite sheets shared by the cards
+ *
+ * There is one sheet per size of the cards in device pixels, which depends on the device pixel
+ * ratio and the scale of the view. The sheets built with the game, see SpriteSheet, are used in
+ * place from the resources. Any other size gets a sheet scaled down from a larger one, or rendered
+ * from the card images when it is larger than all of them. It renders each tile the first time it
+ * is drawn, so a new size costs a single rendering per card and not one per frame.
+ */
+class CardAtlas
+{
+public:
+
+	static constexpr int MAX_SHEETS = 2;
+
+	static CardAtlas& instance();
+
+	[[nodiscard]] static int faceTile(Card::Value value, Card::Suit suit) noexcept;
+	[[nodiscard]] static int backTile() noexcept;
+
+	void draw(QPainter* painter, const QRectF& target, int tile, qreal scale);
+
+protected:
+
+	/*!
+	 * \brief The tiles at a given size
+	 */
+	struct Sheet
+	{
+		QSize							   tileSize;
+		QImage							   image;
+		std::bitset<SpriteSheet::NB_TILES> rendered;
+		bool							   prebuilt = false; //!< Built with the game, and always kept
+	};
+
+	CardAtlas();
+
+	Sheet& sheet(int width);
+	void   renderTile(Sheet& sheet, int tile);
+
+protected:
+
+	std::vector<Sheet> m_sheets;
+	QImage			   m_paper; //!< Decoded for the tiles larger than any prebuilt sheet
+};
+
+#endif // CARDATLAS_H
@@ -0,0 +1,75 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CARDID_H
+#define CARDID_H
+
+#include <cstdint>
+
+/*!
+ * \brief Compact, Qt-free identity of a playing card
+ *
+ * Cards are numbered 0..51, grouped by suit and ordered by value inside a suit. Suits and
+ * values use the same numbering as `Card::Suit` (CLUBS = 1 .. SPADES = 4) and `Card::Value`
+ * (ACE = 1 .. KING = 13) so that the two representations convert without a lookup.
+ */
+using CardId = std::uint8_t;
+
+constexpr int	 NB_SUITS		= 4;
+constexpr int	 NB_VALUES		= 13;
+constexpr int	 NB_CARDS		= NB_SUITS * NB_VALUES;
+constexpr CardId NO_CARD		= 0xFF;
+constexpr int	 SUIT_CLUBS		= 1;
+constexpr int	 SUIT_DIAMONDS	= 2;
+constexpr int	 SUIT_HEARTS	= 3;
+constexpr int	 SUIT_SPADES	= 4;
+constexpr int	 VALUE_ACE		= 1;
+constexpr int	 VALUE_KING		= 13;
+
+/*!
+ * \brief Build a card id from a suit (1..4) and a value (1..13)
+ */
+constexpr CardId cardId(int suit, int value) noexcept
+{
+	return static_cast<CardId>((suit - 1) * NB_VALUES + (value - 1));
+}
+
+/*!
+ * \brief Get the suit (1..4) of a card id
+ */
+constexpr int cardSuit(CardId card) noexcept
+{
+	return card / NB_VALUES + 1;
+}
+
+/*!
+ * \brief Get the value (1..13) of a card id
+ */
+constexpr int cardValue(CardId card) noexcept
+{
+	return card % NB_VALUES + 1;
+}
+
+/*!
+ * \brief Check if a card is red (diamonds or hearts)
+ */
+constexpr bool cardIsRed(CardId card) noexcept
+{
+	return cardSuit(card) == SUIT_DIAMONDS || cardSuit(card) == SUIT_HEARTS;
+}
+
+#endif // CARDID_H
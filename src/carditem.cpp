@@ -15,26 +15,43 @@
  * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "cardproxy.h"
+#include "carditem.h"
 #include "card.h"
-#include "cardspotproxy.h"
+#include "cardatlas.h"
+#include "cardspotitem.h"
 
 #include <QGraphicsScene>
 #include <QGraphicsSceneMouseEvent>
-#include <QWidget>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
 
 /*!
  * \brief Constructor
- * \param card The card linked to this proxy
+ * \param card The card linked to this item
  */
-CardProxy::CardProxy(Card* card)
-	: QGraphicsProxyWidget()
+CardItem::CardItem(Card* card)
+	: QGraphicsObject()
 {
 	mCard = card;
+	mTile = CardAtlas::faceTile(card->getValue(), card->getSuit());
 	setData(0, QVariant("card"));
 }
 
-void CardProxy::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event)
+QRectF CardItem::boundingRect() const
+{
+	return {0, 0, WIDTH, HEIGHT};
+}
+
+/*!
+ * \brief Paint the card with a single copy from the atlas, at the size it has on the screen
+ */
+void CardItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+	qreal scale = option->levelOfDetailFromTransform(painter->worldTransform());
+	CardAtlas::instance().draw(painter, boundingRect(), mTile, scale);
+}
+
+void CardItem::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event)
 {
 	mCard->automaticMove();
 }
@@ -43,11 +60,11 @@ void CardProxy::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event)
  * \brief Handles mouse press events
  * \param event The mouse event
  */
-void CardProxy::mousePressEvent(QGraphicsSceneMouseEvent* event)
+void CardItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
 {
 	if (event->button() == Qt::LeftButton)
 	{
-		if(!mCard->isSelected())
+		if (!mCard->isSelected())
 			mCard->select();
 		else
 			mCard->setSelected(false);
@@ -71,7 +88,7 @@ void CardProxy::mousePressEvent(QGraphicsSceneMouseEvent* event)
  * \brief Handles mouse release events
  * \param event The mouse event
  */
-void CardProxy::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
+void CardItem::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 {
 	if (event->button() == Qt::RightButton)
 	{
@@ -84,7 +101,7 @@ void CardProxy::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 	}
 	else if (event->button() == Qt::LeftButton)
 	{
-		QList<QGraphicsItem*> items		= this->scene()->items(event->scenePos());
+		QList<QGraphicsItem*> items = scene()->items(event->scenePos());
 
 		// if the card is not moved enough, replace it
 		if ((event->buttonDownScenePos(Qt::LeftButton) - event->scenePos()).manhattanLength() < 10)
@@ -100,17 +117,16 @@ void CardProxy::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 			{
 				if (item->data(0) == QVariant("card"))
 				{
-					auto* proxy = dynamic_cast<CardProxy*>(item);
-					if (proxy->mCard->getChild() == nullptr)
+					auto* cardItem = static_cast<CardItem*>(item);
+					if (cardItem->mCard->getChild() == nullptr)
 					{
-						proxy->mCard->select();
+						cardItem->mCard->select();
 						return;
 					}
 				}
 				if (item->data(0) == QVariant("acespot") || item->data(0) == QVariant("freecell") || item->data(0) == QVariant("columnspot"))
 				{
-					auto* proxy = dynamic_cast<CardSpotProxy*>(item);
-					proxy->select();
+					static_cast<CardSpotItem*>(item)->select();
 					return;
 				}
 			}
@@ -125,11 +141,11 @@ void CardProxy::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
  * \brief Handles mouse mouse events
  * \param event The mouse event
  */
-void CardProxy::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
+void CardItem::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
 {
 	if (event->buttons() & Qt::LeftButton)
 	{
 		mCard->setZIndex(100);
 		mCard->setPosition(event->scenePos().toPoint() - event->buttonDownPos(Qt::LeftButton).toPoint());
 	}
-}
\ No newline at end of file
+}
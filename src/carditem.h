@@ -0,0 +1,62 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CARDITEM_H
+#define CARDITEM_H
+
+#include <QGraphicsObject>
+
+#include "spritesheet.h"
+
+class Card;
+
+/*!
+ * \brief The graphics item of a card
+ *
+ * A native item painting its tile of the shared CardAtlas, so that moving or repainting a card
+ * never goes through the widget machinery. It also manages the mouse events over the card.
+ */
+class CardItem : public QGraphicsObject
+{
+	Q_OBJECT
+public:
+
+	constexpr static int WIDTH		   = SpriteSheet::CARD_WIDTH;
+	constexpr static int HEIGHT		   = SpriteSheet::CARD_HEIGHT;
+	constexpr static int BORDER_RADIUS = SpriteSheet::BORDER_RADIUS;
+
+public:
+
+	explicit CardItem(Card* card);
+
+	[[nodiscard]] QRectF boundingRect() const override;
+	void				 paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+protected:
+
+	void mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event) override;
+	void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+	void mouseMoveEvent(QGraphicsSceneMouseEvent* event) override;
+	void mouseReleaseEvent(QGraphicsSceneMouseEvent* event) override;
+
+protected:
+
+	Card* mCard;
+	int	  mTile;
+};
+
+#endif // CARDITEM_H
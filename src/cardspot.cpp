@@ -16,10 +16,10 @@
  */
 
 #include "cardspot.h"
-#include <QGraphicsProxyWidget>
 #include <QPointF>
 #include "board.h"
 #include "card.h"
+#include "cardspotitem.h"
 
 /*!
  * \brief Constructor
@@ -28,7 +28,7 @@
 CardSpot::CardSpot(Board* board)
 	: AbstractCardHolder()
 {
-	mProxy = nullptr;
+	mItem  = nullptr;
 	mBoard = board;
 }
 
@@ -66,7 +66,7 @@ bool CardSpot::isStackable()
  */
 void CardSpot::setPosition(QPointF pos)
 {
-	mProxy->setPos(pos);
+	mItem->setPos(pos);
 }
 
 /*!
@@ -75,7 +75,7 @@ void CardSpot::setPosition(QPointF pos)
  */
 QPoint CardSpot::getChildPosition()
 {
-	return mProxy->pos().toPoint();
+	return mItem->pos().toPoint();
 }
 
 /*!
@@ -86,7 +86,9 @@ void CardSpot::select()
 	Card* card = mBoard->getSelectedCard();
 	if (card && canStackCard(card))
 	{
+		mBoard->beginMove();
 		card->setParent(this, true);
+		mBoard->commitMove();
 	}
 	else if (card)
 	{
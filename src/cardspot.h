@@ -23,7 +23,7 @@
 class Board;
 class Card;
 class QPointF;
-class QGraphicsProxyWidget;
+class CardSpotItem;
 
 /*!
  * \brief The CardSpot class
@@ -45,7 +45,7 @@ public:
 
 protected:
     Board* mBoard;
-    QGraphicsProxyWidget* mProxy;
+    CardSpotItem* mItem;
 };
 
 #endif // CARDSPOT_H
\ No newline at end of file
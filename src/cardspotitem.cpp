@@ -0,0 +1,117 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cardspotitem.h"
+#include "carditem.h"
+#include "cardspot.h"
+
+#include <QGraphicsScene>
+#include <QGraphicsSceneMouseEvent>
+#include <QPainter>
+
+/*!
+ * \brief Constructor
+ * \param cardSpot The card spot object to link
+ * \param parent The parent item
+ */
+CardSpotItem::CardSpotItem(CardSpot* cardSpot, QGraphicsItem* parent)
+	: QGraphicsItem(parent)
+{
+	mCardSpot = cardSpot;
+	setFlag(ItemSendsGeometryChanges);
+}
+
+/*!
+ * \brief Set the image drawn at the center of the spot
+ */
+void CardSpotItem::setPixmap(const QPixmap& pixmap)
+{
+	mPixmap = pixmap;
+	invalidateBackground();
+}
+
+/*!
+ * \brief Access to the card spot object's select() method
+ */
+void CardSpotItem::select()
+{
+	mCardSpot->select();
+}
+
+QRectF CardSpotItem::boundingRect() const
+{
+	return {0, 0, CardItem::WIDTH, CardItem::HEIGHT};
+}
+
+/*!
+ * \brief Paint nothing, the spot is drawn in the background of the scene
+ * \see paintDecoration()
+ */
+void CardSpotItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+}
+
+/*!
+ * \brief Paint the rounded outline of the spot, and its image if any, in item coordinates
+ *
+ * BoardScene draws it once in the cached background of the board, so that the cards moving over
+ * the spot never repaint it.
+ */
+void CardSpotItem::paintDecoration(QPainter* painter) const
+{
+	painter->setRenderHint(QPainter::Antialiasing, true);
+
+	// the pen is centered on the outline, which must stay within the spot
+	qreal inset = BORDER_WIDTH / 2.0;
+	painter->setPen(QPen(Qt::darkGreen, BORDER_WIDTH));
+	painter->setBrush(Qt::NoBrush);
+	painter->drawRoundedRect(boundingRect().adjusted(inset, inset, -inset, -inset), CardItem::BORDER_RADIUS - inset, CardItem::BORDER_RADIUS - inset);
+
+	if (!mPixmap.isNull())
+	{
+		QPointF corner((CardItem::WIDTH - mPixmap.width()) / 2.0, (CardItem::HEIGHT - mPixmap.height()) / 2.0);
+		painter->drawPixmap(corner, mPixmap);
+	}
+}
+
+QVariant CardSpotItem::itemChange(GraphicsItemChange change, const QVariant& value)
+{
+	if (change == ItemPositionHasChanged)
+		invalidateBackground();
+	return QGraphicsItem::itemChange(change, value);
+}
+
+/*!
+ * \brief Have the scene draw its background again, as it holds the decoration of the spot
+ */
+void CardSpotItem::invalidateBackground()
+{
+	if (scene())
+		scene()->invalidate(QRectF(), QGraphicsScene::BackgroundLayer);
+}
+
+/*!
+ * \brief Handles mouse press events
+ * \param event The mouse event
+ */
+void CardSpotItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+	if (event->button() == Qt::LeftButton)
+	{
+		mCardSpot->select();
+	}
+}
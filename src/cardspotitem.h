@@ -0,0 +1,59 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CARDSPOTITEM_H
+#define CARDSPOTITEM_H
+
+#include <QGraphicsItem>
+#include <QPixmap>
+
+class CardSpot;
+
+/*!
+ * \brief The graphics item of any card spot (freecell, ace spot, column spot)
+ *
+ * It handles the mouse events over the spot. Its outline, and the emblem of its suit for an ace
+ * spot, are part of the background of the scene.
+ */
+class CardSpotItem : public QGraphicsItem
+{
+public:
+
+	explicit CardSpotItem(CardSpot* cardSpot, QGraphicsItem* parent = nullptr);
+
+	void setPixmap(const QPixmap& pixmap);
+	void select();
+
+	[[nodiscard]] QRectF boundingRect() const override;
+	void				 paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+	void				 paintDecoration(QPainter* painter) const;
+
+protected:
+
+	QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
+	void	 mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+	void	 invalidateBackground();
+
+protected:
+
+	constexpr static int BORDER_WIDTH = 6;
+
+	CardSpot* mCardSpot;
+	QPixmap	  mPixmap;
+};
+
+#endif // CARDSPOTITEM_H
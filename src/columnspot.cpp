@@ -16,22 +16,14 @@
  */
 
 #include "columnspot.h"
-#include "cardspotproxy.h"
-#include <QFrame>
-#include "cardwidget.h"
+#include "cardspotitem.h"
 #include "board.h"
 
 ColumnSpot::ColumnSpot(Board* board) : CardSpot(board)
 {
-    mProxy = new CardSpotProxy(this);
-	mProxy->setData(0, QVariant("columnspot"));
-
-    auto* widget = new QFrame();
-    widget->resize(CardWidget::WIDTH, CardWidget::HEIGHT);
-	widget->setStyleSheet(QString("background-color:transparent; border: 6px solid darkGreen; border-radius: %1px;").arg(CardWidget::BORDER_RADIUS));
-
-	mProxy->setWidget(widget);
-    mBoard->addItem(mProxy);
+    mItem = new CardSpotItem(this);
+	mItem->setData(0, QVariant("columnspot"));
+    mBoard->addSpot(mItem);
 }
 
 bool ColumnSpot::isStackable()
@@ -0,0 +1,116 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "concurrenttranspositiontable.h"
+
+#include <bit>
+
+namespace
+{
+	constexpr std::uint64_t GENERATION_MASK = 0xFF;
+} // namespace
+
+/*!
+ * \brief Constructor
+ * \param capacity Number of buckets, rounded up to a power of two
+ */
+ConcurrentTranspositionTable::ConcurrentTranspositionTable(std::size_t capacity)
+{
+	capacity = std::bit_ceil(capacity < 16 ? std::size_t(16) : capacity);
+	m_keys	 = std::make_unique<std::atomic<std::uint64_t>[]>(capacity);
+	m_mask	 = capacity - 1;
+}
+
+/*!
+ * \brief Add a position to the table
+ * \param key The hash of the position
+ * \return true if the position wasn't in the table yet. false if it was, or if the table is full.
+ */
+bool ConcurrentTranspositionTable::insert(std::uint64_t key) noexcept
+{
+	if (full())
+	{
+		return false;
+	}
+
+	// buckets of older generations are free
+	key			  = (key & ~GENERATION_MASK) | m_generation;
+	std::size_t i = (key >> 8) & m_mask;
+	while (true)
+	{
+		std::uint64_t current = m_keys[i].load(std::memory_order_relaxed);
+		if (current == key)
+		{
+			return false;
+		}
+		if ((current & GENERATION_MASK) != m_generation)
+		{
+			if (m_keys[i].compare_exchange_strong(current, key, std::memory_order_relaxed))
+			{
+				m_size.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+			// another thread claimed the bucket, maybe for the same key
+			if (current == key)
+			{
+				return false;
+			}
+			if ((current & GENERATION_MASK) != m_generation)
+			{
+				continue;
+			}
+		}
+		i = (i + 1) & m_mask;
+	}
+}
+
+/*!
+ * \brief Check if the table reached its maximum load
+ */
+bool ConcurrentTranspositionTable::full() const noexcept
+{
+	return 4 * m_size.load(std::memory_order_relaxed) >= 3 * (m_mask + 1);
+}
+
+/*!
+ * \brief Forget every position. Must not be called while other threads insert.
+ */
+void ConcurrentTranspositionTable::clear() noexcept
+{
+	m_size = 0;
+	if (++m_generation > GENERATION_MASK)
+	{
+		for (std::size_t i = 0; i <= m_mask; i++)
+		{
+			m_keys[i].store(0, std::memory_order_relaxed);
+		}
+		m_generation = 1;
+	}
+}
+
+std::size_t ConcurrentTranspositionTable::size() const noexcept
+{
+	return m_size.load(std::memory_order_relaxed);
+}
+
+/*!
+ * \brief Get the memory held by the buckets, in bytes
+ */
+std::size_t ConcurrentTranspositionTable::memoryUsage() const noexcept
+{
+	return (m_mask + 1) * sizeof(std::uint64_t);
+}
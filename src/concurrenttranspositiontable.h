@@ -0,0 +1,57 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONCURRENTTRANSPOSITIONTABLE_H
+#define CONCURRENTTRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/*!
+ * \brief Set of visited positions shared by several search threads
+ *
+ * Same layout as `TranspositionTable`, but the buckets are claimed with a compare-and-swap so
+ * that any number of threads can insert without locking. The table can't grow while threads
+ * use it: its capacity is fixed at construction, and it reports itself full at 3/4 load.
+ *
+ * The low byte of each bucket holds the generation it was written in, so that clear() only has
+ * to start a new generation instead of wiping the whole table between two searches.
+ */
+class ConcurrentTranspositionTable
+{
+public:
+
+	explicit ConcurrentTranspositionTable(std::size_t capacity);
+
+	bool			   insert(std::uint64_t key) noexcept;
+	[[nodiscard]] bool full() const noexcept;
+	void			   clear() noexcept;
+
+	[[nodiscard]] std::size_t size() const noexcept;
+	[[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+protected:
+
+	std::unique_ptr<std::atomic<std::uint64_t>[]> m_keys;
+	std::size_t									  m_mask	   = 0;
+	std::atomic<std::size_t>					  m_size	   = 0;
+	std::uint64_t								  m_generation = 1;
+};
+
+#endif // CONCURRENTTRANSPOSITIONTABLE_H
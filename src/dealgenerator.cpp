@@ -0,0 +1,40 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dealgenerator.h"
+
+#include <algorithm>
+
+// Game #1 of the original Freecell starts with JD 2D 9H JC, and ends with 6S 9C 2H 6H
+static_assert(DealGenerator::deal(1)[0] == cardId(SUIT_DIAMONDS, 11));
+static_assert(DealGenerator::deal(1)[3] == cardId(SUIT_CLUBS, 11));
+static_assert(DealGenerator::deal(1)[51] == cardId(SUIT_HEARTS, 6));
+
+/*!
+ * \brief Generate the deals of consecutive game numbers into a flat buffer
+ * \param firstGame The first game number
+ * \param count     The number of deals
+ * \param deals     Receives count * NB_CARDS card ids, one Deal after the other
+ */
+void DealGenerator::fill(std::uint32_t firstGame, std::size_t count, CardId* deals) noexcept
+{
+	for (std::size_t i = 0; i < count; i++)
+	{
+		Deal d = deal(static_cast<std::uint32_t>(firstGame + i));
+		std::ranges::copy(d, deals + i * NB_CARDS);
+	}
+}
@@ -0,0 +1,91 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DEALGENERATOR_H
+#define DEALGENERATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "cardid.h"
+
+/*!
+ * \brief The 52 cards of a deal, in dealing order: card i goes on column i % 8
+ */
+using Deal = std::array<CardId, NB_CARDS>;
+
+/*!
+ * \brief Deterministic deal generator, compatible with the Microsoft Freecell numbering
+ *
+ * Game numbers are the seeds of the Microsoft C runtime `rand()`, a linear congruential
+ * generator, and the deck is drawn the way the original Freecell does it: game #1 starts with
+ * the jack of diamonds, game #11982 is the famous unsolvable one. Any game number from 1 to
+ * MAX_GAME_NUMBER is valid, so the 7-digit numbers of this game are simply a larger range of
+ * the same numbering.
+ *
+ * The generator only handles card ids, and is usable in constant expressions.
+ */
+class DealGenerator
+{
+public:
+
+	static constexpr std::uint32_t MAX_GAME_NUMBER = 0x7FFFFFFF;
+
+public:
+
+	static constexpr Deal deal(std::uint32_t gameNumber) noexcept;
+	static void			  fill(std::uint32_t firstGame, std::size_t count, CardId* deals) noexcept;
+
+protected:
+
+	/*!
+	 * \brief Convert the Microsoft card index (value * 4 + suit, clubs first) to a card id
+	 */
+	static constexpr CardId fromMicrosoftIndex(int index) noexcept
+	{
+		return cardId(index % NB_SUITS + 1, index / NB_SUITS + 1);
+	}
+};
+
+/*!
+ * \brief Generate the deal of a game number
+ */
+constexpr Deal DealGenerator::deal(std::uint32_t gameNumber) noexcept
+{
+	std::array<std::uint8_t, NB_CARDS> deck{};
+	for (int i = 0; i < NB_CARDS; i++)
+	{
+		deck[i] = static_cast<std::uint8_t>(i);
+	}
+
+	Deal		  deal{};
+	std::uint32_t seed = gameNumber;
+	for (int i = 0; i < NB_CARDS; i++)
+	{
+		// rand() of the Microsoft C runtime
+		seed = (seed * 214013u + 2531011u) & 0x7FFFFFFF;
+		int left = NB_CARDS - i;
+		int j	 = static_cast<int>(seed >> 16) % left;
+
+		deal[i] = fromMicrosoftIndex(deck[j]);
+		deck[j] = deck[left - 1];
+	}
+	return deal;
+}
+
+#endif // DEALGENERATOR_H
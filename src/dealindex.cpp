@@ -0,0 +1,189 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dealindex.h"
+
+#include <cstring>
+
+#include "gamestate.h"
+
+/*!
+ * \brief Constructor
+ *
+ * The view is left invalid if the bytes don't hold an index of the current format and deal
+ * generator.
+ *
+ * \param data The content of an index file. It must outlive the view.
+ * \param size The size of the content, in bytes
+ */
+DealIndex::DealIndex(const std::uint8_t* data, std::size_t size) noexcept
+{
+	if (!data || size < sizeof(DealIndexHeader))
+	{
+		return;
+	}
+
+	const auto* header = reinterpret_cast<const DealIndexHeader*>(data);
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+		header->generatorVersion != GameState::DEAL_GENERATOR_VERSION || size < fileSize(header->count))
+	{
+		return;
+	}
+
+	m_header  = header;
+	m_entries = data + sizeof(DealIndexHeader);
+}
+
+bool DealIndex::isValid() const noexcept
+{
+	return m_header != nullptr;
+}
+
+std::uint32_t DealIndex::firstGame() const noexcept
+{
+	return m_header ? m_header->firstGame : 0;
+}
+
+std::uint32_t DealIndex::count() const noexcept
+{
+	return m_header ? m_header->count : 0;
+}
+
+/*!
+ * \brief Check if the index has an entry for a game number
+ */
+bool DealIndex::contains(std::uint32_t gameNumber) const noexcept
+{
+	return m_header && gameNumber >= m_header->firstGame && gameNumber - m_header->firstGame < m_header->count;
+}
+
+/*!
+ * \brief Get the 4-bit entry of a game number, NOT_SCANNED if the index doesn't cover it
+ */
+std::uint8_t DealIndex::entry(std::uint32_t gameNumber) const noexcept
+{
+	if (!contains(gameNumber))
+	{
+		return NOT_SCANNED;
+	}
+	return entryAt(gameNumber - m_header->firstGame);
+}
+
+bool DealIndex::isSolvable(std::uint32_t gameNumber) const noexcept
+{
+	return entry(gameNumber) & SOLVABLE;
+}
+
+/*!
+ * \brief Get the difficulty of a solvable game, 0 if it isn't known to be solvable
+ */
+int DealIndex::difficulty(std::uint32_t gameNumber) const noexcept
+{
+	std::uint8_t e = entry(gameNumber);
+	return e & SOLVABLE ? e & DIFFICULTY_MASK : 0;
+}
+
+/*!
+ * \brief Draw a random solvable game number within a difficulty band
+ *
+ * Random entries are drawn until one matches, so that a lookup takes microseconds for usual
+ * bands. Should a band be very rare, the entries are walked from a random start instead.
+ *
+ * \return The game number, 0 if the index has no matching game
+ */
+std::uint32_t DealIndex::sample(std::mt19937& generator, int minDifficulty, int maxDifficulty) const
+{
+	if (!m_header || m_header->count == 0)
+	{
+		return 0;
+	}
+
+	auto matches = [&](std::uint32_t index)
+	{
+		std::uint8_t e			= entryAt(index);
+		int			 difficulty = e & DIFFICULTY_MASK;
+		return (e & SOLVABLE) && difficulty >= minDifficulty && difficulty <= maxDifficulty;
+	};
+
+	std::uniform_int_distribution<std::uint32_t> distribution(0, m_header->count - 1);
+	for (int i = 0; i < MAX_DRAWS; i++)
+	{
+		std::uint32_t index = distribution(generator);
+		if (matches(index))
+		{
+			return m_header->firstGame + index;
+		}
+	}
+
+	std::uint32_t start = distribution(generator);
+	for (std::uint32_t i = 0; i < m_header->count; i++)
+	{
+		std::uint32_t index = (start + i) % m_header->count;
+		if (matches(index))
+		{
+			return m_header->firstGame + index;
+		}
+	}
+	return 0;
+}
+
+/*!
+ * \brief Build the header of a new index file
+ * \param firstGame The game number of the first entry
+ * \param count     The number of entries
+ * \param nodeLimit The node budget of the solver for each deal
+ */
+DealIndexHeader DealIndex::makeHeader(std::uint32_t firstGame, std::uint32_t count, std::uint32_t nodeLimit) noexcept
+{
+	DealIndexHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version			= VERSION;
+	header.generatorVersion = GameState::DEAL_GENERATOR_VERSION;
+	header.firstGame		= firstGame;
+	header.count			= count;
+	header.nodeLimit		= nodeLimit;
+	return header;
+}
+
+/*!
+ * \brief Get the size of an index file holding a number of entries, in bytes
+ */
+std::size_t DealIndex::fileSize(std::uint32_t count) noexcept
+{
+	return sizeof(DealIndexHeader) + (std::size_t(count) + 1) / 2;
+}
+
+/*!
+ * \brief Get the entry of a solved deal
+ *
+ * The difficulty grows with the number of positions the solver had to expand: below 32 is
+ * difficulty 1, and each further factor of 4 adds one, up to MAX_DIFFICULTY.
+ */
+std::uint8_t DealIndex::solvedEntry(std::uint64_t nodesExpanded) noexcept
+{
+	int difficulty = MIN_DIFFICULTY;
+	for (std::uint64_t bound = 32; nodesExpanded >= bound && difficulty < MAX_DIFFICULTY; bound *= 4)
+	{
+		difficulty++;
+	}
+	return SOLVABLE | static_cast<std::uint8_t>(difficulty);
+}
+
+std::uint8_t DealIndex::entryAt(std::uint32_t index) const noexcept
+{
+	return (m_entries[index / 2] >> (4 * (index % 2))) & 0xF;
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DEALINDEX_H
+#define DEALINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+/*!
+ * \brief Header of a deal index file
+ *
+ * The file holds one nibble per game number, two per byte, low nibble first, right after the
+ * header. Integers are stored in the native byte order of the machine that wrote the file, so
+ * that the header can be used in place: a file is only portable between machines of the same
+ * endianness.
+ */
+struct DealIndexHeader
+{
+	char		  magic[8];			//!< DealIndex::MAGIC
+	std::uint32_t version;			//!< DealIndex::VERSION
+	std::uint32_t generatorVersion; //!< GameState::DEAL_GENERATOR_VERSION used for the scan
+	std::uint32_t firstGame;		//!< Game number of the first entry
+	std::uint32_t count;			//!< Number of entries
+	std::uint32_t nodeLimit;		//!< Node budget of the solver for each deal
+	std::uint32_t reserved;
+};
+
+static_assert(sizeof(DealIndexHeader) == 32);
+
+/*!
+ * \brief Read-only view over the solvability and difficulty of a range of game numbers
+ *
+ * Each game number has a 4-bit entry: the high bit is set when the deal is solvable, and the
+ * low 3 bits hold its difficulty, from 1 (trivial) to 7 (hardest). Entries without the
+ * solvable bit hold NOT_SCANNED, UNSOLVABLE or UNDECIDED instead.
+ *
+ * The view does not own its bytes, so that a memory-mapped file can be used as is.
+ */
+class DealIndex
+{
+public:
+
+	static constexpr char		   MAGIC[8] = {'F', 'C', 'D', 'E', 'A', 'L', 'I', 'X'};
+	static constexpr std::uint32_t VERSION	= 1;
+
+	static constexpr std::uint8_t SOLVABLE		  = 0x8;
+	static constexpr std::uint8_t DIFFICULTY_MASK = 0x7;
+	static constexpr std::uint8_t NOT_SCANNED	  = 0x0;
+	static constexpr std::uint8_t UNSOLVABLE	  = 0x1; //!< The whole search space was explored
+	static constexpr std::uint8_t UNDECIDED		  = 0x2; //!< The solver ran out of budget
+
+	static constexpr int MIN_DIFFICULTY = 1;
+	static constexpr int MAX_DIFFICULTY = 7;
+
+public:
+
+	DealIndex() = default;
+	DealIndex(const std::uint8_t* data, std::size_t size) noexcept;
+
+	[[nodiscard]] bool			isValid() const noexcept;
+	[[nodiscard]] std::uint32_t firstGame() const noexcept;
+	[[nodiscard]] std::uint32_t count() const noexcept;
+	[[nodiscard]] bool			contains(std::uint32_t gameNumber) const noexcept;
+
+	[[nodiscard]] std::uint8_t entry(std::uint32_t gameNumber) const noexcept;
+	[[nodiscard]] bool		   isSolvable(std::uint32_t gameNumber) const noexcept;
+	[[nodiscard]] int		   difficulty(std::uint32_t gameNumber) const noexcept;
+
+	[[nodiscard]] std::uint32_t sample(std::mt19937& generator, int minDifficulty = MIN_DIFFICULTY, int maxDifficulty = MAX_DIFFICULTY) const;
+
+	static DealIndexHeader makeHeader(std::uint32_t firstGame, std::uint32_t count, std::uint32_t nodeLimit) noexcept;
+	static std::size_t	   fileSize(std::uint32_t count) noexcept;
+	static std::uint8_t	   solvedEntry(std::uint64_t nodesExpanded) noexcept;
+
+protected:
+
+	// Number of random draws before sample() falls back to a linear walk
+	static constexpr int MAX_DRAWS = 4096;
+
+	[[nodiscard]] std::uint8_t entryAt(std::uint32_t index) const noexcept;
+
+protected:
+
+	const DealIndexHeader* m_header	 = nullptr;
+	const std::uint8_t*	   m_entries = nullptr;
+};
+
+#endif // DEALINDEX_H
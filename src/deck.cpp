@@ -19,9 +19,9 @@
 #include "card.h"
 
 #include <algorithm>
-#include <random>
 
 #include "board.h"
+#include "dealgenerator.h"
 
 /*!
  * \brief Constructor
@@ -35,13 +35,21 @@ Deck::Deck(Board* board)
 /*!
  * \brief Shuffle the cards in this deck
  *
- * The cards are randomly reordered in the deck. Any number of cards can be
- * present in the deck.
+ * The cards are reordered so that drawing them deals the game `seed` of
+ * `DealGenerator`. Any number of cards can be present in the deck.
  */
 void Deck::shuffle(unsigned int seed)
 {
-	std::mt19937 generator{seed};
-	std::ranges::shuffle(mCards, generator);
+	Deal deal = DealGenerator::deal(seed);
+
+	std::array<int, NB_CARDS> position{};
+	for (int i = 0; i < NB_CARDS; i++)
+	{
+		position[deal[i]] = i;
+	}
+
+	// cards are drawn from the back
+	std::ranges::sort(mCards, [&](Card* lhs, Card* rhs) { return position[lhs->getId()] > position[rhs->getId()]; });
 }
 
 /*!
@@ -54,13 +62,6 @@ void Deck::shuffle(unsigned int seed)
  */
 void Deck::build(Board* board)
 {
-	for (auto* card : mCards)
-	{
-		if (card)
-			card->deleteLater();
-	}
-	mCards.clear();
-
 	for (auto i = static_cast<Card::Suit>(1); i < Card::Suit::LASTSUIT; ++i)
 	{
 		for (Card::Value j = Card::Value::ACE; j < Card::Value::LASTVALUE; ++j)
@@ -89,7 +90,7 @@ Card* Deck::drawCard()
  */
 void Deck::pushCard(Card* card)
 {
-	card->setScattered(false);
+	card->reset();
 	mCards.push_back(card);
 }
 
@@ -109,4 +110,4 @@ int Deck::getSize() const
 bool Deck::empty() const noexcept
 {
 	return mCards.empty();
-}
\ No newline at end of file
+}
@@ -17,10 +17,8 @@
 
 #include "freecell.h"
 #include "board.h"
-#include "cardwidget.h"
-#include "cardspotproxy.h"
-
-#include <QFrame>
+#include "cardspotitem.h"
+#include "rules.h"
 
 /*!
  * \brief Constructor
@@ -28,14 +26,9 @@
  */
 Freecell::Freecell(Board* board) : CardSpot(board)
 {
-    mProxy = new CardSpotProxy(this);
-    mProxy->setData(0, QVariant("freecell"));
-
-    auto* widget = new QFrame();
-    widget->resize(CardWidget::WIDTH, CardWidget::HEIGHT);
-	widget->setStyleSheet(QString("background-color:transparent; border: 6px solid darkGreen; border-radius: %1px;").arg(CardWidget::BORDER_RADIUS));
-    mProxy->setWidget(widget);
-    mBoard->addItem(mProxy);
+    mItem = new CardSpotItem(this);
+    mItem->setData(0, QVariant("freecell"));
+    mBoard->addSpot(mItem);
 }
 
 bool Freecell::isStackable()
@@ -45,5 +38,5 @@ bool Freecell::isStackable()
 
 bool Freecell::canStackCard(Card* card)
 {
-	return isEmpty() && card->isMovable() && !card->getChild() && card->getValue() != Card::Value::ACE;
+	return isEmpty() && canGoToFreecell(card->getId()) && !card->getChild() && card->isMovable();
 }
\ No newline at end of file
@@ -0,0 +1,632 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamestate.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "dealgenerator.h"
+#include "rules.h"
+
+namespace
+{
+	// What a card lies on, for the Zobrist keys: another card (its id), or one of these
+	constexpr int ON_COLUMN		= NB_CARDS;									 // + the column, except for canonical keys
+	constexpr int ON_FREECELL	= ON_COLUMN + GameState::NB_COLUMNS;		 // + the freecell, except for canonical keys
+	constexpr int ON_FOUNDATION = ON_FREECELL + GameState::NB_FREECELLS;
+	constexpr int NB_SUPPORTS	= ON_FOUNDATION + 1;
+
+	/*!
+	 * \brief Random keys of the Zobrist hash, one per card and per thing it can lie on
+	 */
+	constexpr auto ZOBRIST_KEYS = []
+	{
+		std::array<std::array<std::uint64_t, NB_SUPPORTS>, NB_CARDS> keys{};
+		std::uint64_t												 seed = 0x9E3779B97F4A7C15ULL;
+		for (auto& card : keys)
+		{
+			for (auto& key : card)
+			{
+				// splitmix64
+				seed += 0x9E3779B97F4A7C15ULL;
+				std::uint64_t x = seed;
+				x				= (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				x				= (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+				key				= x ^ (x >> 31);
+			}
+		}
+		return keys;
+	}();
+} // namespace
+
+/*!
+ * \brief Constructor. Builds an empty position.
+ */
+GameState::GameState()
+{
+	clear();
+}
+
+/*!
+ * \brief Build the initial position of a game
+ *
+ * The cards are dealt like `Board::dealCards` does, one per column in turn, in the order
+ * of `DealGenerator::deal`.
+ *
+ * \param gameNumber The game number
+ */
+GameState GameState::fromGameNumber(unsigned int gameNumber)
+{
+	Deal deal = DealGenerator::deal(gameNumber);
+
+	GameState state;
+	for (int i = 0; i < NB_CARDS; i++)
+	{
+		state.pushToColumn(i % NB_COLUMNS, deal[i]);
+	}
+	return state;
+}
+
+/*!
+ * \brief Remove every card from the position
+ */
+void GameState::clear()
+{
+	m_cards.fill(NO_CARD);
+	m_columnSizes.fill(0);
+	m_freecells.fill(NO_CARD);
+	m_foundations.fill(0);
+	m_runLengths.fill(0);
+	m_freeCellCount	   = NB_FREECELLS;
+	m_emptyColumnCount = NB_COLUMNS;
+	m_hash			   = 0;
+	m_canonicalHash	   = 0;
+}
+
+/*!
+ * \brief Deal a card on top of a column
+ * \param column The column (0..7)
+ * \param card   The card to deal
+ */
+void GameState::pushToColumn(int column, CardId card)
+{
+	put(FIRST_COLUMN + column, &card, 1);
+}
+
+/*!
+ * \brief Get the number of cards in a column
+ */
+int GameState::columnSize(int column) const noexcept
+{
+	return m_columnSizes[column];
+}
+
+/*!
+ * \brief Get a card of a column
+ * \param column The column (0..7)
+ * \param index  The position in the column, 0 being the card lying on the column spot
+ */
+CardId GameState::columnCard(int column, int index) const noexcept
+{
+	return m_cards[columnOffset(column) + index];
+}
+
+/*!
+ * \brief Get the card in a freecell, or NO_CARD
+ */
+CardId GameState::freecell(int cell) const noexcept
+{
+	return m_freecells[cell];
+}
+
+/*!
+ * \brief Get the number of cards on a foundation
+ * \param index The foundation, i.e. the suit - 1
+ */
+int GameState::foundation(int index) const noexcept
+{
+	return m_foundations[index];
+}
+
+/*!
+ * \brief Get the top card of any slot, or NO_CARD if the slot is empty
+ */
+CardId GameState::topCard(int slot) const noexcept
+{
+	if (isColumn(slot))
+	{
+		int size = m_columnSizes[slot - FIRST_COLUMN];
+		return size ? m_cards[columnOffset(slot - FIRST_COLUMN) + size - 1] : NO_CARD;
+	}
+	if (isFreecell(slot))
+	{
+		return m_freecells[slot - FIRST_FREECELL];
+	}
+
+	int index = slot - FIRST_FOUNDATION;
+	return m_foundations[index] ? cardId(index + 1, m_foundations[index]) : NO_CARD;
+}
+
+/*!
+ * \brief Get the number of cards in any slot
+ */
+int GameState::slotSize(int slot) const noexcept
+{
+	if (isColumn(slot))
+	{
+		return m_columnSizes[slot - FIRST_COLUMN];
+	}
+	if (isFreecell(slot))
+	{
+		return m_freecells[slot - FIRST_FREECELL] != NO_CARD ? 1 : 0;
+	}
+	return m_foundations[slot - FIRST_FOUNDATION];
+}
+
+int GameState::countFreeCells() const noexcept
+{
+	return m_freeCellCount;
+}
+
+int GameState::countEmptyColumns() const noexcept
+{
+	return m_emptyColumnCount;
+}
+
+/*!
+ * \brief Get the largest stack that can be moved at once
+ * \param toEmptyColumn Whether the destination is an empty column, which then can't be used as temporary storage
+ * \return The number of cards
+ */
+int GameState::maxMovableCards(bool toEmptyColumn) const noexcept
+{
+	int emptyColumns = countEmptyColumns() - (toEmptyColumn ? 1 : 0);
+	return (countFreeCells() + 1) << (emptyColumns > 0 ? emptyColumns : 0);
+}
+
+/*!
+ * \brief Get the length of the ordered run (alternate colors, descending values) on top of a column
+ */
+int GameState::runLength(int column) const noexcept
+{
+	return m_runLengths[column];
+}
+
+int GameState::cardsOnFoundations() const noexcept
+{
+	return m_foundations[0] + m_foundations[1] + m_foundations[2] + m_foundations[3];
+}
+
+bool GameState::isWon() const noexcept
+{
+	return cardsOnFoundations() == NB_CARDS;
+}
+
+/*!
+ * \brief Get the Zobrist hash of the position
+ *
+ * The hash is the XOR of one random key per card, picked by what the card lies on: another
+ * card, the spot of a column, a freecell or a foundation. A move only changes what the bottom
+ * card of the moved stack lies on, so the hash is updated in constant time whatever the size
+ * of the stack.
+ */
+std::uint64_t GameState::zobristHash() const noexcept
+{
+	return m_hash;
+}
+
+/*!
+ * \brief Get the Zobrist hash of the position, ignoring the order of the freecells and of the columns
+ *
+ * The spots of all the columns share the same keys, as do all the freecells: positions that
+ * only differ by a permutation of the freecells or of the columns are the same position as
+ * far as solving is concerned, and get the same hash.
+ */
+std::uint64_t GameState::canonicalHash() const noexcept
+{
+	return m_canonicalHash;
+}
+
+/*!
+ * \brief Compute the Zobrist hash from scratch, to check the incremental one
+ * \param canonical Whether to ignore the order of the freecells and of the columns, as canonicalHash() does
+ */
+std::uint64_t GameState::computeHash(bool canonical) const noexcept
+{
+	std::uint64_t hash = 0;
+	for (int column = 0, offset = 0; column < NB_COLUMNS; offset += m_columnSizes[column++])
+	{
+		for (int i = 0; i < m_columnSizes[column]; i++)
+		{
+			int support = i > 0 ? m_cards[offset + i - 1] : ON_COLUMN + (canonical ? 0 : column);
+			hash ^= ZOBRIST_KEYS[m_cards[offset + i]][support];
+		}
+	}
+	for (int cell = 0; cell < NB_FREECELLS; cell++)
+	{
+		if (m_freecells[cell] != NO_CARD)
+		{
+			hash ^= ZOBRIST_KEYS[m_freecells[cell]][ON_FREECELL + (canonical ? 0 : cell)];
+		}
+	}
+	for (int foundation = 0; foundation < NB_FOUNDATIONS; foundation++)
+	{
+		for (int value = VALUE_ACE; value <= m_foundations[foundation]; value++)
+		{
+			hash ^= ZOBRIST_KEYS[cardId(foundation + 1, value)][ON_FOUNDATION];
+		}
+	}
+	return hash;
+}
+
+/*!
+ * \brief Check a move against the rules of the game
+ * \param move The move to check
+ * \return true if the move can be applied
+ */
+bool GameState::isLegal(StateMove move) const noexcept
+{
+	if (move.from == move.to || move.from >= NB_SLOTS || move.to >= NB_SLOTS || !move.isValid())
+	{
+		return false;
+	}
+
+	// cards never leave the foundations, and only stacks from a column move together
+	if (isFoundation(move.from) || slotSize(move.from) < move.count)
+	{
+		return false;
+	}
+	if (isFreecell(move.from) && move.count != 1)
+	{
+		return false;
+	}
+	if (isColumn(move.from) && move.count > runLength(move.from - FIRST_COLUMN))
+	{
+		return false;
+	}
+
+	CardId card = isColumn(move.from) ? columnCard(move.from - FIRST_COLUMN, columnSize(move.from - FIRST_COLUMN) - move.count) : topCard(move.from);
+
+	if (isFoundation(move.to))
+	{
+		int foundation = move.to - FIRST_FOUNDATION;
+		return move.count == 1 && isNextOnFoundation(foundation, m_foundations[foundation], card);
+	}
+	if (isFreecell(move.to))
+	{
+		return move.count == 1 && m_freecells[move.to - FIRST_FREECELL] == NO_CARD && canGoToFreecell(card);
+	}
+
+	CardId parent = topCard(move.to);
+	if (parent == NO_CARD)
+	{
+		return move.count <= maxMovableCards(true);
+	}
+	return canStackOnTableau(parent, card) && move.count <= maxMovableCards(false);
+}
+
+/*!
+ * \brief Generate the legal moves of the position
+ *
+ * Moves to the foundations come first. Moves to equivalent destinations (empty freecells,
+ * empty columns) are only generated for the first of them.
+ *
+ * \param moves Output buffer, of at least MAX_MOVES entries
+ * \return The number of moves written
+ */
+int GameState::legalMoves(StateMove* moves) const noexcept
+{
+	int n = 0;
+
+	int firstFreecell = -1;
+	for (int cell = 0; cell < NB_FREECELLS; cell++)
+	{
+		if (m_freecells[cell] == NO_CARD)
+		{
+			firstFreecell = cell;
+			break;
+		}
+	}
+
+	int firstEmptyColumn = -1;
+	for (int column = 0; column < NB_COLUMNS; column++)
+	{
+		if (m_columnSizes[column] == 0)
+		{
+			firstEmptyColumn = column;
+			break;
+		}
+	}
+
+	CardId tops[NB_SLOTS];
+	for (int slot = 0; slot < FIRST_FOUNDATION; slot++)
+	{
+		tops[slot] = topCard(slot);
+	}
+
+	// to the foundations
+	for (int slot = 0; slot < FIRST_FOUNDATION; slot++)
+	{
+		CardId card = tops[slot];
+		if (card != NO_CARD && isNextOnFoundation(foundationIndex(card), m_foundations[foundationIndex(card)], card))
+		{
+			moves[n++] = {static_cast<std::uint8_t>(slot), static_cast<std::uint8_t>(FIRST_FOUNDATION + foundationIndex(card)), 1};
+		}
+	}
+
+	int toColumn	  = maxMovableCards(false);
+	int toEmptyColumn = maxMovableCards(true);
+
+	// from the freecells to the columns
+	for (int cell = 0; cell < NB_FREECELLS; cell++)
+	{
+		CardId card = m_freecells[cell];
+		if (card == NO_CARD)
+		{
+			continue;
+		}
+		for (int column = 0; column < NB_COLUMNS; column++)
+		{
+			CardId parent = tops[column];
+			if ((parent == NO_CARD && column == firstEmptyColumn) || (parent != NO_CARD && canStackOnTableau(parent, card)))
+			{
+				moves[n++] = {static_cast<std::uint8_t>(FIRST_FREECELL + cell), static_cast<std::uint8_t>(column), 1};
+			}
+		}
+	}
+
+	// from a column to another
+	for (int from = 0; from < NB_COLUMNS; from++)
+	{
+		int size = m_columnSizes[from];
+		if (size == 0)
+		{
+			continue;
+		}
+
+		const CardId* cards = m_cards.data() + columnOffset(from);
+		int			  run	= runLength(from);
+
+		for (int to = 0; to < NB_COLUMNS; to++)
+		{
+			if (to == from)
+			{
+				continue;
+			}
+
+			CardId parent = tops[to];
+			if (parent != NO_CARD)
+			{
+				// only one card of an ordered run can fit over a given parent
+				int count = cardValue(parent) - cardValue(cards[size - 1]);
+				if (count >= 1 && count <= run && count <= toColumn && canStackOnTableau(parent, cards[size - count]))
+				{
+					moves[n++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), static_cast<std::uint8_t>(count)};
+				}
+			}
+			else if (to == firstEmptyColumn)
+			{
+				// moving a whole column to an empty one is pointless
+				int maxCount = run < toEmptyColumn ? run : toEmptyColumn;
+				if (maxCount == size)
+				{
+					maxCount--;
+				}
+				for (int count = maxCount; count >= 1; count--)
+				{
+					moves[n++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), static_cast<std::uint8_t>(count)};
+				}
+			}
+		}
+
+		// from a column to a freecell
+		if (firstFreecell >= 0 && canGoToFreecell(cards[size - 1]))
+		{
+			moves[n++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(FIRST_FREECELL + firstFreecell), 1};
+		}
+	}
+
+	assert(n <= MAX_MOVES);
+	return n;
+}
+
+/*!
+ * \brief Apply a move. The move is not checked against the rules, see isLegal().
+ */
+void GameState::apply(StateMove move) noexcept
+{
+	CardId cards[NB_VALUES];
+	assert(move.count <= NB_VALUES);
+
+	take(move.from, move.count, cards);
+	put(move.to, cards, move.count);
+}
+
+/*!
+ * \brief Revert a move previously applied with apply()
+ */
+void GameState::unapply(StateMove move) noexcept
+{
+	apply(move.reversed());
+}
+
+/*!
+ * \brief Get the index of the first card of a column in `m_cards`
+ */
+int GameState::columnOffset(int column) const noexcept
+{
+	int offset = 0;
+	for (int i = 0; i < column; i++)
+	{
+		offset += m_columnSizes[i];
+	}
+	return offset;
+}
+
+/*!
+ * \brief Get the number of cards in all the columns
+ */
+int GameState::columnCardCount() const noexcept
+{
+	return columnOffset(NB_COLUMNS);
+}
+
+/*!
+ * \brief Measure the ordered run on top of a column by walking down the column
+ */
+int GameState::scanRunLength(int column) const noexcept
+{
+	int size = m_columnSizes[column];
+	if (size == 0)
+	{
+		return 0;
+	}
+
+	const CardId* cards = m_cards.data() + columnOffset(column);
+	int			  run	= 1;
+	while (run < size && canStackOnTableau(cards[size - run - 1], cards[size - run]))
+	{
+		run++;
+	}
+	return run;
+}
+
+/*!
+ * \brief Remove cards from the top of a slot
+ * \param slot  The slot
+ * \param count The number of cards
+ * \param cards Receives the removed cards, bottom card first
+ */
+void GameState::take(int slot, int count, CardId* cards) noexcept
+{
+	if (isColumn(slot))
+	{
+		int column = slot - FIRST_COLUMN;
+		int end	   = columnOffset(column) + m_columnSizes[column];
+		int total  = columnCardCount();
+
+		CardId bottom = m_cards[end - count];
+		if (m_columnSizes[column] > count)
+		{
+			CardId parent = m_cards[end - count - 1];
+			toggleHash(bottom, parent, parent);
+		}
+		else
+		{
+			toggleHash(bottom, ON_COLUMN + column, ON_COLUMN);
+		}
+
+		std::memcpy(cards, m_cards.data() + end - count, count);
+		std::memmove(m_cards.data() + end - count, m_cards.data() + end, total - end);
+		std::memset(m_cards.data() + total - count, NO_CARD, count);
+		m_columnSizes[column] -= count;
+
+		if (m_columnSizes[column] == 0)
+		{
+			m_emptyColumnCount++;
+			m_runLengths[column] = 0;
+		}
+		else if (count < m_runLengths[column])
+		{
+			m_runLengths[column] -= count;
+		}
+		else
+		{
+			// the run is gone, the one below it starts wherever the order breaks
+			m_runLengths[column] = scanRunLength(column);
+		}
+	}
+	else if (isFreecell(slot))
+	{
+		cards[0]						 = m_freecells[slot - FIRST_FREECELL];
+		m_freecells[slot - FIRST_FREECELL] = NO_CARD;
+		m_freeCellCount++;
+		toggleHash(cards[0], ON_FREECELL + slot - FIRST_FREECELL, ON_FREECELL);
+	}
+	else
+	{
+		int index = slot - FIRST_FOUNDATION;
+		cards[0]  = cardId(index + 1, m_foundations[index]);
+		m_foundations[index]--;
+		toggleHash(cards[0], ON_FOUNDATION, ON_FOUNDATION);
+	}
+}
+
+/*!
+ * \brief Add cards on top of a slot
+ * \param slot  The slot
+ * \param cards The cards, bottom card first
+ * \param count The number of cards
+ */
+void GameState::put(int slot, const CardId* cards, int count) noexcept
+{
+	if (isColumn(slot))
+	{
+		int column = slot - FIRST_COLUMN;
+		int end	   = columnOffset(column) + m_columnSizes[column];
+		int total  = columnCardCount();
+
+		std::memmove(m_cards.data() + end + count, m_cards.data() + end, total - end);
+		std::memcpy(m_cards.data() + end, cards, count);
+
+		int run = 1;
+		while (run < count && canStackOnTableau(cards[count - run - 1], cards[count - run]))
+		{
+			run++;
+		}
+		if (m_columnSizes[column] == 0)
+		{
+			m_emptyColumnCount--;
+			toggleHash(cards[0], ON_COLUMN + column, ON_COLUMN);
+		}
+		else
+		{
+			CardId parent = m_cards[end - 1];
+			toggleHash(cards[0], parent, parent);
+			if (run == count && canStackOnTableau(parent, cards[0]))
+			{
+				run += m_runLengths[column];
+			}
+		}
+		m_runLengths[column] = static_cast<std::uint8_t>(run);
+		m_columnSizes[column] += count;
+	}
+	else if (isFreecell(slot))
+	{
+		m_freecells[slot - FIRST_FREECELL] = cards[0];
+		m_freeCellCount--;
+		toggleHash(cards[0], ON_FREECELL + slot - FIRST_FREECELL, ON_FREECELL);
+	}
+	else
+	{
+		m_foundations[slot - FIRST_FOUNDATION] = cardValue(cards[0]);
+		toggleHash(cards[0], ON_FOUNDATION, ON_FOUNDATION);
+	}
+}
+
+/*!
+ * \brief Add or remove the Zobrist keys of a card lying on something
+ * \param card             The card
+ * \param support          What the card lies on
+ * \param canonicalSupport What the card lies on, regardless of the order of the freecells and columns
+ */
+void GameState::toggleHash(CardId card, int support, int canonicalSupport) noexcept
+{
+	m_hash ^= ZOBRIST_KEYS[card][support];
+	m_canonicalHash ^= ZOBRIST_KEYS[card][canonicalSupport];
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <array>
+#include <cstdint>
+
+#include "cardid.h"
+
+/*!
+ * \brief A move between two slots of a `GameState`
+ *
+ * Slots are numbered 0..7 for the columns, 8..11 for the freecells and 12..15 for the
+ * foundations (one per suit, in `Card::Suit` order). `count` is the number of cards taken
+ * from the top of the source slot.
+ */
+struct StateMove
+{
+	std::uint8_t from  = 0;
+	std::uint8_t to	   = 0;
+	std::uint8_t count = 0;
+
+	[[nodiscard]] constexpr bool isValid() const noexcept
+	{
+		return count != 0;
+	}
+
+	[[nodiscard]] constexpr StateMove reversed() const noexcept
+	{
+		return {to, from, count};
+	}
+
+	constexpr bool operator==(const StateMove&) const = default;
+};
+
+/*!
+ * \brief Headless, packed representation of a Freecell position
+ *
+ * The cards of the 8 columns are stored back to back in a single 52 byte array, followed by
+ * the column sizes, the 4 freecells and the 4 foundation heights. The number of free cells,
+ * of empty columns, the length of the ordered run on top of each column and the Zobrist hashes
+ * are maintained as moves are applied, so that the rules and the hashes answer in constant
+ * time: the whole position fits in 96 bytes and can be copied with `memcpy`. No `QObject` is
+ * involved, so the rules can be evaluated without a `QGraphicsScene`.
+ *
+ * The rules mirror `Card::canStackCard`, `Freecell::canStackCard` and `AceSpot::canStackCard`.
+ * Aces never go to a freecell. A stack of cards may only move when it fits through the empty
+ * freecells and columns; a column receiving the stack does not count as an empty column.
+ */
+class GameState
+{
+public:
+
+	static constexpr int NB_COLUMNS		= 8;
+	static constexpr int NB_FREECELLS	= 4;
+	static constexpr int NB_FOUNDATIONS = 4;
+
+	static constexpr int FIRST_COLUMN	  = 0;
+	static constexpr int FIRST_FREECELL	  = FIRST_COLUMN + NB_COLUMNS;
+	static constexpr int FIRST_FOUNDATION = FIRST_FREECELL + NB_FREECELLS;
+	static constexpr int NB_SLOTS		  = FIRST_FOUNDATION + NB_FOUNDATIONS;
+
+	static constexpr int MAX_MOVES = 256;
+
+	//! Bumped whenever fromGameNumber deals differently, which invalidates any deal index
+	static constexpr std::uint32_t DEAL_GENERATOR_VERSION = 2;
+
+public:
+
+	GameState();
+
+	static GameState fromGameNumber(unsigned int gameNumber);
+
+	void clear();
+	void pushToColumn(int column, CardId card);
+
+	[[nodiscard]] int	 columnSize(int column) const noexcept;
+	[[nodiscard]] CardId columnCard(int column, int index) const noexcept;
+	[[nodiscard]] CardId freecell(int cell) const noexcept;
+	[[nodiscard]] int	 foundation(int index) const noexcept;
+	[[nodiscard]] CardId topCard(int slot) const noexcept;
+	[[nodiscard]] int	 slotSize(int slot) const noexcept;
+
+	[[nodiscard]] int  countFreeCells() const noexcept;
+	[[nodiscard]] int  countEmptyColumns() const noexcept;
+	[[nodiscard]] int  maxMovableCards(bool toEmptyColumn) const noexcept;
+	[[nodiscard]] int  runLength(int column) const noexcept;
+	[[nodiscard]] int  cardsOnFoundations() const noexcept;
+	[[nodiscard]] bool isWon() const noexcept;
+
+	[[nodiscard]] std::uint64_t zobristHash() const noexcept;
+	[[nodiscard]] std::uint64_t canonicalHash() const noexcept;
+	[[nodiscard]] std::uint64_t computeHash(bool canonical) const noexcept;
+
+	[[nodiscard]] bool isLegal(StateMove move) const noexcept;
+	int				   legalMoves(StateMove* moves) const noexcept;
+
+	void apply(StateMove move) noexcept;
+	void unapply(StateMove move) noexcept;
+
+	bool operator==(const GameState&) const = default;
+
+	static constexpr bool isColumn(int slot) noexcept
+	{
+		return slot >= FIRST_COLUMN && slot < FIRST_FREECELL;
+	}
+
+	static constexpr bool isFreecell(int slot) noexcept
+	{
+		return slot >= FIRST_FREECELL && slot < FIRST_FOUNDATION;
+	}
+
+	static constexpr bool isFoundation(int slot) noexcept
+	{
+		return slot >= FIRST_FOUNDATION && slot < NB_SLOTS;
+	}
+
+protected:
+
+	[[nodiscard]] int columnOffset(int column) const noexcept;
+	[[nodiscard]] int columnCardCount() const noexcept;
+	[[nodiscard]] int scanRunLength(int column) const noexcept;
+
+	void take(int slot, int count, CardId* cards) noexcept;
+	void put(int slot, const CardId* cards, int count) noexcept;
+	void toggleHash(CardId card, int support, int canonicalSupport) noexcept;
+
+protected:
+
+	std::array<CardId, NB_CARDS>				 m_cards;
+	std::array<std::uint8_t, NB_COLUMNS>		 m_columnSizes;
+	std::array<CardId, NB_FREECELLS>			 m_freecells;
+	std::array<std::uint8_t, NB_FOUNDATIONS> m_foundations;
+
+	// kept up to date by take() and put(), so that the rules never scan the position
+	std::array<std::uint8_t, NB_COLUMNS> m_runLengths;
+	std::uint8_t						 m_freeCellCount;
+	std::uint8_t						 m_emptyColumnCount;
+	std::uint64_t						 m_hash;
+	std::uint64_t						 m_canonicalHash;
+};
+
+#endif // GAMESTATE_H
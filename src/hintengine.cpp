@@ -0,0 +1,100 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hintengine.h"
+
+#include <chrono>
+
+/*!
+ * \brief Constructor
+ * \param limits The budget of each search
+ */
+HintEngine::HintEngine(SolverLimits limits)
+	: QObject()
+	, m_limits(limits)
+	, m_session(limits)
+{
+}
+
+/*!
+ * \brief Follow a new game
+ */
+void HintEngine::reset(GameState start)
+{
+	m_session.reset(start);
+}
+
+/*!
+ * \brief Follow a move of the game
+ */
+void HintEngine::play(StateMove move)
+{
+	m_session.play(move);
+}
+
+/*!
+ * \brief Search a winning move from a position
+ *
+ * Searches cancelled before they start are skipped, and cancelled ones don't report anything:
+ * their requester already moved on.
+ * \param state     The position, copied at the time of the request
+ * \param stopToken Cancels the search
+ * \param request   Identifies the request in hintReady()
+ */
+void HintEngine::search(GameState state, std::stop_token stopToken, quint64 request)
+{
+	if (stopToken.stop_requested())
+		return;
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	// the position of the request wins over the moves the engine was told about
+	m_session.sync(state);
+	auto move	= m_session.hint(stopToken);
+	auto result = m_session.lastResult();
+	if (result == Solver::Result::Cancelled)
+		return;
+
+	emit hintReady(request, move, result, std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+}
+
+/*!
+ * \brief Search a whole solution from a position, to tell whether it can be won
+ *
+ * The search starts afresh rather than from the solutions of the session, so that the number of
+ * moves reported is the length of an actual solution. Like search(), a cancelled analysis
+ * doesn't report anything.
+ * \param state     The position, copied at the time of the request
+ * \param stopToken Cancels the search
+ * \param request   Identifies the request in analysisReady()
+ */
+void HintEngine::analyze(GameState state, std::stop_token stopToken, quint64 request)
+{
+	if (stopToken.stop_requested())
+		return;
+
+	Solver solver(m_limits);
+	auto   result = solver.solve(state, stopToken);
+	if (result == Solver::Result::Cancelled)
+		return;
+
+	const auto& stats = solver.stats();
+	qInfo("Solver: %s in %.1f ms, %llu nodes expanded, %.0f states/s, peak memory %zu KiB", Solver::resultName(result), stats.seconds * 1000.0,
+		  static_cast<unsigned long long>(stats.nodesExpanded), stats.statesPerSecond(), stats.peakMemory / 1024);
+
+	emit analysisReady(request, result, static_cast<int>(solver.solution().size()));
+}
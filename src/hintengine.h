@@ -0,0 +1,78 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HINTENGINE_H
+#define HINTENGINE_H
+
+#include <QObject>
+#include <stop_token>
+
+#include "gamestate.h"
+#include "solversession.h"
+
+/*!
+ * \brief Search of the next move to play, meant to live on a worker thread
+ *
+ * The engine is moved to its own thread, and searches are queued to it with search(). Each
+ * search works on its own copy of the position, and reports through the hintReady() signal, so
+ * that the requester never waits for it. A search is cancelled through the stop token it was
+ * given: the requester can stop it as soon as the position it was asked for is outdated.
+ *
+ * The engine follows the game through reset() and play(), queued like the searches, so that
+ * its SolverSession answers at once while the player follows or comes back to a solution.
+ * analyze() runs a whole search from a position the same way, to tell whether it can be won.
+ */
+class HintEngine : public QObject
+{
+	Q_OBJECT
+public:
+
+	explicit HintEngine(SolverLimits limits = {});
+
+public slots:
+
+	void reset(GameState start);
+	void play(StateMove move);
+	void search(GameState state, std::stop_token stopToken, quint64 request);
+	void analyze(GameState state, std::stop_token stopToken, quint64 request);
+
+signals:
+
+	/*!
+	 * \brief Result of a search
+	 * \param request The request number given to search()
+	 * \param move    The first move of a winning sequence, invalid if none was found
+	 * \param result  The outcome of the search
+	 * \param seconds The time spent searching
+	 */
+	void hintReady(quint64 request, StateMove move, Solver::Result result, double seconds);
+
+	/*!
+	 * \brief Result of an analysis
+	 * \param request The request number given to analyze()
+	 * \param result  The outcome of the search
+	 * \param moves   The number of moves of the solution, if one was found
+	 */
+	void analysisReady(quint64 request, Solver::Result result, int moves);
+
+protected:
+
+	SolverLimits  m_limits;
+	SolverSession m_session;
+};
+
+#endif // HINTENGINE_H
@@ -3,7 +3,7 @@
 //
 
 #include "label.h"
-#include "cardwidget.h"
+#include "carditem.h"
 
 Label::Label(QWidget* parent)
 	: QLabel(parent)
@@ -17,7 +17,7 @@ Label::Label(QWidget* parent)
 			  "	 border: 6px solid rgba(0, 100, 0, 255);"
 			  "	 border-radius: 15px"
 			  "}");
-	setFixedWidth(CardWidget::WIDTH);
+	setFixedWidth(CardItem::WIDTH);
 	setFixedHeight(46);
 	setAlignment(Qt::AlignCenter);
 }
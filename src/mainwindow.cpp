@@ -18,6 +18,7 @@
 #include "mainwindow.h"
 #include "board.h"
 
+#include <QActionGroup>
 #include <QApplication>
 #include <QInputDialog>
 #include <QMenuBar>
@@ -42,10 +43,58 @@ MainWindow::MainWindow(QWidget* parent)
 	gameMenu->addAction(QIcon(":/icons/freecell_ico_white"), "New Game", Qt::Key_F2, m_board, &Board::newGame);
 	gameMenu->addAction("Select Game...", Qt::Key_F4, m_board, &Board::selectGame);
 	gameMenu->addAction("Restart Game", Qt::Key_F5, m_board, &Board::restartGame);
+	gameMenu->addAction("Is This Game Winnable?", Qt::Key_F6, m_board, &Board::checkWinnable);
+	gameMenu->addAction("Hint", Qt::Key_H, m_board, &Board::showHint);
+	gameMenu->addSeparator();
+
+	// dealing solvable games requires the index written by freecell-dealscan
+	auto* solvableAction = gameMenu->addAction("Solvable Deals Only");
+	solvableAction->setCheckable(true);
+	solvableAction->setEnabled(m_board->hasDealIndex());
+	connect(solvableAction, &QAction::toggled, this, [this](bool value) { m_board->setSolvableOnly(value); });
+
+	struct DifficultyBand
+	{
+		const char* name;
+		int			minDifficulty;
+		int			maxDifficulty;
+	};
+	const DifficultyBand bands[] = {{"Any", 1, 7}, {"Easy", 1, 2}, {"Medium", 3, 4}, {"Hard", 5, 6}, {"Expert", 7, 7}};
+
+	auto* difficultyMenu  = gameMenu->addMenu("Difficulty");
+	auto* difficultyGroup = new QActionGroup(difficultyMenu);
+	for (const auto& band : bands)
+	{
+		auto* action = difficultyMenu->addAction(band.name);
+		action->setCheckable(true);
+		action->setChecked(band.minDifficulty == DealIndex::MIN_DIFFICULTY && band.maxDifficulty == DealIndex::MAX_DIFFICULTY);
+		difficultyGroup->addAction(action);
+		connect(action, &QAction::triggered, this, [this, band] { m_board->setDifficultyRange(band.minDifficulty, band.maxDifficulty); });
+	}
+	difficultyMenu->setEnabled(false);
+	connect(solvableAction, &QAction::toggled, difficultyMenu, &QMenu::setEnabled);
 	gameMenu->addSeparator();
 	gameMenu->addAction(QIcon(":/icons/undo"), "Undo Last Move", QKeySequence(QKeySequence::Undo), m_board, &Board::onUndo, Qt::QueuedConnection);
 	gameMenu->addAction(QIcon(":/icons/redo"),"Redo Last Move", QKeySequence(QKeySequence::Redo), m_board, &Board::onRedo, Qt::QueuedConnection);
 	gameMenu->addSeparator();
+
+	struct AutoplayChoice
+	{
+		const char*	   name;
+		Autoplay::Mode mode;
+	};
+	const AutoplayChoice autoplayChoices[] = {{"Off", Autoplay::Mode::Off}, {"Safe Cards", Autoplay::Mode::Safe}, {"All Cards", Autoplay::Mode::All}};
+
+	auto* autoplayMenu	= gameMenu->addMenu("Autoplay");
+	auto* autoplayGroup = new QActionGroup(autoplayMenu);
+	for (const auto& choice : autoplayChoices)
+	{
+		auto* action = autoplayMenu->addAction(choice.name);
+		action->setCheckable(true);
+		action->setChecked(choice.mode == Autoplay::Mode::Safe);
+		autoplayGroup->addAction(action);
+		connect(action, &QAction::triggered, this, [this, choice] { m_board->setAutoplayMode(choice.mode); });
+	}
 	auto* relaxedAction = gameMenu->addAction("Relaxed Mode", QKeySequence(Qt::ALT | Qt::Key_R), this, [this](bool value) { m_board->setRelaxed(value); });
 	relaxedAction->setCheckable(true);
 	gameMenu->addSeparator();
@@ -0,0 +1,141 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*!
+ * \brief Constructor, mapping a file
+ * \see open()
+ */
+MappedFile::MappedFile(const char* path)
+{
+	open(path);
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/*!
+ * \brief Map a file, unmapping the previous one
+ *
+ * Empty files can't be mapped, and are reported as failures.
+ *
+ * \return false if the file can't be opened or mapped
+ */
+bool MappedFile::open(const char* path)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER size;
+	HANDLE		  mapping = nullptr;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+	const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!view)
+	{
+		if (mapping)
+		{
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+		return false;
+	}
+	m_file	  = file;
+	m_mapping = mapping;
+	m_data	  = static_cast<const std::uint8_t*>(view);
+	m_size	  = static_cast<std::size_t>(size.QuadPart);
+#else
+	int file = ::open(path, O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat status;
+	void*		view = MAP_FAILED;
+	if (fstat(file, &status) == 0 && status.st_size > 0)
+	{
+		view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	}
+	// the mapping keeps the file alive
+	::close(file);
+	if (view == MAP_FAILED)
+	{
+		return false;
+	}
+	m_data = static_cast<const std::uint8_t*>(view);
+	m_size = static_cast<std::size_t>(status.st_size);
+#endif
+	return true;
+}
+
+/*!
+ * \brief Unmap the file. The views over its bytes must not be used anymore.
+ */
+void MappedFile::close() noexcept
+{
+	if (!m_data)
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mapping);
+	CloseHandle(m_file);
+	m_file	  = nullptr;
+	m_mapping = nullptr;
+#else
+	munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool MappedFile::isOpen() const noexcept
+{
+	return m_data != nullptr;
+}
+
+const std::uint8_t* MappedFile::data() const noexcept
+{
+	return m_data;
+}
+
+std::size_t MappedFile::size() const noexcept
+{
+	return m_size;
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \brief Read-only memory mapping of a whole file
+ *
+ * The headless tools map their input files rather than reading them, so that a file of several
+ * gigabytes is paged in on demand and views such as `SolutionFile` can use its bytes as is.
+ * This is the Qt-free counterpart of `QFile::map`.
+ */
+class MappedFile
+{
+public:
+
+	MappedFile() = default;
+	explicit MappedFile(const char* path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&)			 = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool open(const char* path);
+	void close() noexcept;
+
+	[[nodiscard]] bool				  isOpen() const noexcept;
+	[[nodiscard]] const std::uint8_t* data() const noexcept;
+	[[nodiscard]] std::size_t		  size() const noexcept;
+
+protected:
+
+	const std::uint8_t* m_data = nullptr;
+	std::size_t			m_size = 0;
+#ifdef _WIN32
+	void* m_file	= nullptr;
+	void* m_mapping = nullptr;
+#endif
+};
+
+#endif // MAPPEDFILE_H
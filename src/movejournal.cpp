@@ -0,0 +1,160 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "movejournal.h"
+
+#include <algorithm>
+#include <bit>
+
+/*!
+ * \brief Constructor
+ * \param capacity The number of moves kept, rounded up to a power of two
+ */
+MoveJournal::MoveJournal(std::size_t capacity)
+{
+	capacity = std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity);
+	m_entries.resize(capacity);
+	m_mask = capacity - 1;
+}
+
+/*!
+ * \brief Add a move after the cursor. The moves that could be redone are dropped.
+ * \param move   The move
+ * \param linked Whether the move completes the previous one, see JournalEntry
+ */
+void MoveJournal::record(StateMove move, bool linked)
+{
+	m_end = m_cursor;
+	if (m_end - m_first == m_entries.size())
+	{
+		m_first++;
+	}
+	m_entries[m_end & m_mask] = JournalEntry::fromMove(move, linked);
+	m_cursor				  = ++m_end;
+}
+
+/*!
+ * \brief Step back before the last move
+ * \return The move to revert, an invalid move if there is none
+ */
+StateMove MoveJournal::undo() noexcept
+{
+	if (!canUndo())
+	{
+		return {};
+	}
+	return m_entries[--m_cursor & m_mask].move();
+}
+
+/*!
+ * \brief Step forward over the next move
+ * \return The move to play again, an invalid move if there is none
+ */
+StateMove MoveJournal::redo() noexcept
+{
+	if (!canRedo())
+	{
+		return {};
+	}
+	return m_entries[m_cursor++ & m_mask].move();
+}
+
+/*!
+ * \brief Move the cursor after a given number of moves, without reporting the moves stepped over
+ * \param position The number of moves before the cursor, clamped to size()
+ */
+void MoveJournal::seek(std::size_t position) noexcept
+{
+	m_cursor = m_first + std::min(position, size());
+}
+
+/*!
+ * \brief Forget every move
+ */
+void MoveJournal::clear() noexcept
+{
+	m_first	 = 0;
+	m_cursor = 0;
+	m_end	 = 0;
+}
+
+bool MoveJournal::canUndo() const noexcept
+{
+	return m_cursor != m_first;
+}
+
+bool MoveJournal::canRedo() const noexcept
+{
+	return m_cursor != m_end;
+}
+
+/*!
+ * \brief Get the number of moves in the journal, undoable and redoable
+ */
+std::size_t MoveJournal::size() const noexcept
+{
+	return m_end - m_first;
+}
+
+/*!
+ * \brief Get the number of moves before the cursor
+ */
+std::size_t MoveJournal::position() const noexcept
+{
+	return m_cursor - m_first;
+}
+
+/*!
+ * \brief Get the number of moves forgotten since the journal was cleared
+ *
+ * offset() + position() is the number of moves played since the start of the game.
+ */
+std::uint64_t MoveJournal::offset() const noexcept
+{
+	return m_first;
+}
+
+/*!
+ * \brief Get a move of the journal, 0 being the oldest one
+ */
+StateMove MoveJournal::at(std::size_t index) const noexcept
+{
+	return m_entries[(m_first + index) & m_mask].move();
+}
+
+/*!
+ * \brief Check if a move of the journal completes the previous one, 0 being the oldest move
+ */
+bool MoveJournal::isLinked(std::size_t index) const noexcept
+{
+	return m_entries[(m_first + index) & m_mask].linked();
+}
+
+/*!
+ * \brief Get the memory holding the moves, oldest first
+ *
+ * The ring buffer may wrap around, in which case the moves are split in two segments. Writing
+ * both segments one after the other gives the whole journal.
+ */
+std::array<std::span<const JournalEntry>, 2> MoveJournal::segments() const noexcept
+{
+	std::size_t begin = m_first & m_mask;
+	std::size_t count = size();
+	std::size_t first = std::min(count, m_entries.size() - begin);
+
+	return {std::span<const JournalEntry>(m_entries.data() + begin, first), std::span<const JournalEntry>(m_entries.data(), count - first)};
+}
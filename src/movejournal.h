@@ -0,0 +1,106 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOVEJOURNAL_H
+#define MOVEJOURNAL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "gamestate.h"
+
+/*!
+ * \brief A move packed in 2 bytes: the source slot in the low nibble of the first byte, the
+ * destination slot in its high nibble, and the number of cards in the low bits of the second byte
+ *
+ * The high bit of the second byte links the move to the previous one: both were played as a
+ * single compound move, like a move and the autoplay that followed it, and go back together.
+ */
+struct JournalEntry
+{
+	static constexpr std::uint8_t LINKED = 0x80;
+
+	std::uint8_t fromTo = 0;
+	std::uint8_t count = 0;
+
+	static constexpr JournalEntry fromMove(StateMove move, bool linked = false) noexcept
+	{
+		return {static_cast<std::uint8_t>(move.from | (move.to << 4)), static_cast<std::uint8_t>(move.count | (linked ? LINKED : 0))};
+	}
+
+	[[nodiscard]] constexpr StateMove move() const noexcept
+	{
+		return {static_cast<std::uint8_t>(fromTo & 0xF), static_cast<std::uint8_t>(fromTo >> 4), static_cast<std::uint8_t>(count & ~LINKED)};
+	}
+
+	[[nodiscard]] constexpr bool linked() const noexcept
+	{
+		return count & LINKED;
+	}
+};
+
+static_assert(sizeof(JournalEntry) == 2);
+
+/*!
+ * \brief History of the moves of a game, for undo and redo
+ *
+ * The moves are stored as `JournalEntry` in a ring buffer of fixed capacity. The entries before
+ * the cursor can be undone, the ones after it redone; recording a move drops the redoable ones.
+ * Once the buffer is full, the oldest moves are forgotten.
+ *
+ * Since entries are plain bytes referring to slots rather than to cards, the journal survives
+ * a redeal of the same game, and segments() exposes its memory to be written as is.
+ */
+class MoveJournal
+{
+public:
+
+	static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+public:
+
+	explicit MoveJournal(std::size_t capacity = DEFAULT_CAPACITY);
+
+	void	  record(StateMove move, bool linked = false);
+	StateMove undo() noexcept;
+	StateMove redo() noexcept;
+	void	  seek(std::size_t position) noexcept;
+	void	  clear() noexcept;
+
+	[[nodiscard]] bool			canUndo() const noexcept;
+	[[nodiscard]] bool			canRedo() const noexcept;
+	[[nodiscard]] std::size_t	size() const noexcept;
+	[[nodiscard]] std::size_t	position() const noexcept;
+	[[nodiscard]] std::uint64_t offset() const noexcept;
+	[[nodiscard]] StateMove		at(std::size_t index) const noexcept;
+	[[nodiscard]] bool			isLinked(std::size_t index) const noexcept;
+
+	[[nodiscard]] std::array<std::span<const JournalEntry>, 2> segments() const noexcept;
+
+protected:
+
+	std::vector<JournalEntry> m_entries;
+	std::size_t				  m_mask   = 0;
+	std::uint64_t			  m_first  = 0; //!< Oldest entry
+	std::uint64_t			  m_cursor = 0; //!< Next entry to redo
+	std::uint64_t			  m_end	   = 0; //!< One past the newest entry
+};
+
+#endif // MOVEJOURNAL_H
@@ -0,0 +1,228 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "notation.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+
+#include "rules.h"
+
+namespace
+{
+	constexpr std::uint8_t NO_SLOT = 0xFF;
+
+	//! [character]: the slot it names, FIRST_FOUNDATION for any foundation, NO_SLOT if none
+	constexpr std::array<std::uint8_t, 256> SLOT_OF_SYMBOL = []
+	{
+		std::array<std::uint8_t, 256> table{};
+		table.fill(NO_SLOT);
+		for (int column = 0; column < GameState::NB_COLUMNS; column++)
+		{
+			table['1' + column] = static_cast<std::uint8_t>(GameState::FIRST_COLUMN + column);
+		}
+		for (int cell = 0; cell < GameState::NB_FREECELLS; cell++)
+		{
+			table['a' + cell] = static_cast<std::uint8_t>(GameState::FIRST_FREECELL + cell);
+			table['A' + cell] = static_cast<std::uint8_t>(GameState::FIRST_FREECELL + cell);
+		}
+		table['h'] = GameState::FIRST_FOUNDATION;
+		table['H'] = GameState::FIRST_FOUNDATION;
+		return table;
+	}();
+
+	constexpr bool isSeparator(char c) noexcept
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	char symbolOf(int slot) noexcept
+	{
+		if (GameState::isColumn(slot))
+		{
+			return static_cast<char>('1' + slot - GameState::FIRST_COLUMN);
+		}
+		if (GameState::isFreecell(slot))
+		{
+			return static_cast<char>('a' + slot - GameState::FIRST_FREECELL);
+		}
+		return 'h';
+	}
+
+	/*!
+	 * \brief Get the number of cards the notation of a move implies
+	 * \return The count, 0 if no count fits
+	 */
+	int impliedCount(const GameState& state, int from, int to) noexcept
+	{
+		if (!GameState::isColumn(from) || !GameState::isColumn(to))
+		{
+			return 1;
+		}
+
+		int	   run	  = state.runLength(from - GameState::FIRST_COLUMN);
+		CardId parent = state.topCard(to);
+		if (parent == NO_CARD)
+		{
+			return std::min(run, state.maxMovableCards(true));
+		}
+
+		// the values of the run grow by one per card from its top
+		int count = cardValue(parent) - cardValue(state.topCard(from));
+		return count >= 1 && count <= run ? count : 0;
+	}
+} // namespace
+
+/*!
+ * \brief Write the notation of a move
+ * \param state The position the move is played from
+ * \param move  A legal move of the position
+ * \param out   Output buffer, of at least MAX_NOTATION_LENGTH characters. It is not null-terminated.
+ * \return The number of characters written
+ */
+int formatMove(const GameState& state, StateMove move, char* out) noexcept
+{
+	out[0] = symbolOf(move.from);
+	out[1] = symbolOf(move.to);
+	if (move.count == impliedCount(state, move.from, move.to))
+	{
+		return 2;
+	}
+	out[2] = '/';
+	return static_cast<int>(std::to_chars(out + 3, out + MAX_NOTATION_LENGTH, move.count).ptr - out);
+}
+
+/*!
+ * \brief Read the notation of a move
+ * \param state The position the move is played from
+ * \param move  Receives the move
+ * \return The end of the notation, nullptr if it isn't the notation of a legal move
+ */
+const char* parseMove(const GameState& state, const char* begin, const char* end, StateMove& move) noexcept
+{
+	if (end - begin < 2)
+	{
+		return nullptr;
+	}
+	std::uint8_t from = SLOT_OF_SYMBOL[static_cast<unsigned char>(begin[0])];
+	std::uint8_t to	  = SLOT_OF_SYMBOL[static_cast<unsigned char>(begin[1])];
+	if (from == NO_SLOT || to == NO_SLOT || GameState::isFoundation(from))
+	{
+		return nullptr;
+	}
+	begin += 2;
+
+	// `h` names the foundation of the moved card
+	if (GameState::isFoundation(to))
+	{
+		CardId card = state.topCard(from);
+		if (card == NO_CARD)
+		{
+			return nullptr;
+		}
+		to = static_cast<std::uint8_t>(GameState::FIRST_FOUNDATION + foundationIndex(card));
+	}
+
+	int count = 0;
+	if (begin != end && *begin == '/')
+	{
+		auto [next, error] = std::from_chars(begin + 1, end, count);
+		if (error != std::errc() || count > NB_VALUES)
+		{
+			return nullptr;
+		}
+		begin = next;
+	}
+	else
+	{
+		count = impliedCount(state, from, to);
+	}
+
+	move = {from, to, static_cast<std::uint8_t>(count)};
+	return state.isLegal(move) ? begin : nullptr;
+}
+
+/*!
+ * \brief Append the notation of a solution, as one line
+ * \param gameNumber The game number of the deal
+ * \param moves      The moves of the solution, from the deal of the game
+ * \param count      The number of moves
+ * \param out        Receives the line, newline included
+ */
+void formatSolution(std::uint32_t gameNumber, const StateMove* moves, std::size_t count, std::string& out)
+{
+	char number[16];
+	out.append(number, std::to_chars(number, number + sizeof(number), gameNumber).ptr);
+	out += ':';
+
+	GameState state = GameState::fromGameNumber(gameNumber);
+	char	  notation[1 + MAX_NOTATION_LENGTH] = {' '};
+	for (std::size_t i = 0; i < count; i++)
+	{
+		out.append(notation, 1 + formatMove(state, moves[i], notation + 1));
+		state.apply(moves[i]);
+	}
+	out += '\n';
+}
+
+/*!
+ * \brief Read a solution line
+ *
+ * Every move is checked against the rules as it is replayed, but the final position is not
+ * required to be won.
+ *
+ * \param gameNumber Receives the game number
+ * \param moves      Receives the moves
+ * \return The start of the next line, nullptr if the line isn't a solution of legal moves
+ */
+const char* parseSolution(const char* begin, const char* end, std::uint32_t& gameNumber, std::vector<StateMove>& moves)
+{
+	auto [next, error] = std::from_chars(begin, end, gameNumber);
+	if (error != std::errc() || next == end || *next != ':')
+	{
+		return nullptr;
+	}
+	begin = next + 1;
+
+	moves.clear();
+	GameState state = GameState::fromGameNumber(gameNumber);
+	while (true)
+	{
+		while (begin != end && isSeparator(*begin))
+		{
+			begin++;
+		}
+		if (begin == end)
+		{
+			return end;
+		}
+		if (*begin == '\n')
+		{
+			return begin + 1;
+		}
+
+		StateMove move;
+		begin = parseMove(state, begin, end, move);
+		if (!begin || (begin != end && !isSeparator(*begin) && *begin != '\n'))
+		{
+			return nullptr;
+		}
+		state.apply(move);
+		moves.push_back(move);
+	}
+}
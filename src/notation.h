@@ -0,0 +1,51 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gamestate.h"
+
+/*!
+ * \file notation.h
+ * \brief Standard text notation of Freecell moves and solutions
+ *
+ * A move is written as its source and its destination: `1` to `8` for the columns, `a` to `d`
+ * for the freecells and `h` for the foundations, e.g. `3a`, `a5` or `4h`. The number of cards
+ * is implied: the part of the run that fits on the destination card moves, and as many cards
+ * as possible move to an empty column. A move of fewer cards to an empty column is followed by
+ * a slash and its count, e.g. `37/2`.
+ *
+ * A solution is one line: the game number, a colon, then the moves separated by spaces, e.g.
+ * `1000042: 3a 4h 37/2`. Moves are resolved against the position they are played from, so a
+ * solution is parsed by replaying it from its deal.
+ */
+
+//! Longest notation of a move, e.g. `37/12`
+inline constexpr int MAX_NOTATION_LENGTH = 5;
+
+int			formatMove(const GameState& state, StateMove move, char* out) noexcept;
+const char* parseMove(const GameState& state, const char* begin, const char* end, StateMove& move) noexcept;
+
+void		formatSolution(std::uint32_t gameNumber, const StateMove* moves, std::size_t count, std::string& out);
+const char* parseSolution(const char* begin, const char* end, std::uint32_t& gameNumber, std::vector<StateMove>& moves);
+
+#endif // NOTATION_H
@@ -0,0 +1,381 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "parallelsolver.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+	// Number of positions handed over at once to hungry workers
+	constexpr std::size_t SHARE_BATCH = 4;
+
+	/*!
+	 * \brief Heap order of the open lists: lowest priority first, then most recent first
+	 */
+	template<class Item>
+	bool isWorse(const Item& lhs, const Item& rhs) noexcept
+	{
+		return lhs.priority != rhs.priority ? lhs.priority > rhs.priority : lhs.sequence < rhs.sequence;
+	}
+} // namespace
+
+/*!
+ * \brief Constructor
+ * \param threadCount The number of worker threads, 0 for one per core
+ * \param limits      The budget of each search, shared by all the workers
+ */
+ParallelSolver::ParallelSolver(unsigned int threadCount, SolverLimits limits)
+	: m_threadCount(threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+	, m_limits(limits)
+{
+}
+
+/*!
+ * \brief Search a winning sequence of moves with all the worker threads
+ * \param start The position to solve
+ * \return Solved if solution() holds a winning sequence
+ */
+Solver::Result ParallelSolver::solve(const GameState& start)
+{
+	auto startTime = std::chrono::steady_clock::now();
+
+	m_stats = {};
+	m_solution.clear();
+	m_stop	   = false;
+	m_busy	   = 1;
+	m_hungry   = static_cast<int>(m_threadCount) - 1;
+	m_expanded = 0;
+	m_result   = Solver::Result::Unsolvable;
+	m_winner   = NO_NODE;
+
+	// a quarter of the memory budget goes to the shared table, the rest to the workers
+	std::size_t buckets = std::min(std::bit_floor(m_limits.maxMemory / 4 / sizeof(std::uint64_t)), std::bit_ceil(m_limits.maxNodes * 16));
+	if (m_visited && m_visited->memoryUsage() == buckets * sizeof(std::uint64_t))
+	{
+		m_visited->clear();
+	}
+	else
+	{
+		m_visited = std::make_unique<ConcurrentTranspositionTable>(buckets);
+	}
+
+	m_workers.clear();
+	for (unsigned int i = 0; i < m_threadCount; i++)
+	{
+		m_workers.push_back(std::make_unique<Worker>());
+	}
+
+	// the first worker starts with the root, the others steal from it
+	Worker&	  first = *m_workers.front();
+	GameState root	= start;
+	Solver::autoplay(root, first.moves);
+	first.nodes.push_back({NO_NODE, 0, static_cast<std::uint8_t>(first.moves.size())});
+	m_visited->insert(root.canonicalHash());
+
+	if (root.isWon())
+	{
+		m_result = Solver::Result::Solved;
+		m_winner = 0;
+	}
+	else
+	{
+		first.open.push_back({root, 0, 0, 0, 0});
+
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0; i < m_threadCount; i++)
+		{
+			threads.emplace_back(&ParallelSolver::run, this, i);
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	if (m_result == Solver::Result::Solved)
+	{
+		buildSolution(m_winner);
+	}
+
+	m_stats.peakMemory = m_visited->memoryUsage();
+	for (const auto& worker : m_workers)
+	{
+		m_stats.nodesExpanded += worker->nodesExpanded;
+		m_stats.nodesGenerated += worker->nodesGenerated;
+		m_stats.peakMemory += memoryUsage(*worker);
+	}
+	m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	return m_result;
+}
+
+/*!
+ * \brief Get the winning moves found by the last successful search
+ */
+const std::vector<StateMove>& ParallelSolver::solution() const noexcept
+{
+	return m_solution;
+}
+
+const SolverStats& ParallelSolver::stats() const noexcept
+{
+	return m_stats;
+}
+
+unsigned int ParallelSolver::threadCount() const noexcept
+{
+	return m_threadCount;
+}
+
+/*!
+ * \brief Main loop of a worker thread
+ * \param index The index of the worker
+ */
+void ParallelSolver::run(unsigned int index)
+{
+	Worker&		worker		 = *m_workers[index];
+	bool		busy		 = index == 0;
+	std::size_t memoryBudget = (m_limits.maxMemory - m_visited->memoryUsage()) / m_threadCount;
+
+	StateMove legalMoves[GameState::MAX_MOVES];
+	while (!m_stop.load(std::memory_order_relaxed))
+	{
+		WorkItem item;
+		if (!take(worker, item))
+		{
+			if (busy)
+			{
+				busy = false;
+				m_hungry++;
+				if (--m_busy == 0)
+				{
+					// nobody holds any position anymore: the search space is exhausted
+					stop(Solver::Result::Unsolvable);
+					break;
+				}
+			}
+			// read before looking, so that a position shared in between wakes the worker at once
+			std::uint32_t offers = m_offers.load(std::memory_order_acquire);
+			if (!steal(index, item))
+			{
+				m_offers.wait(offers, std::memory_order_acquire);
+				continue;
+			}
+			busy = true;
+			m_hungry--;
+		}
+
+		if (m_expanded.fetch_add(1, std::memory_order_relaxed) >= m_limits.maxNodes)
+		{
+			stop(Solver::Result::NodeLimit);
+			break;
+		}
+		if (m_visited->full() || ((worker.nodesExpanded & 0xFF) == 0 && memoryUsage(worker) > memoryBudget))
+		{
+			stop(Solver::Result::MemoryLimit);
+			break;
+		}
+
+		expand(index, item, legalMoves);
+
+		if (m_hungry.load(std::memory_order_relaxed) > 0)
+		{
+			share(worker);
+		}
+	}
+}
+
+/*!
+ * \brief Generate the children of a position and add the new ones to the worker's open list
+ */
+void ParallelSolver::expand(unsigned int index, const WorkItem& item, StateMove* legalMoves)
+{
+	Worker& worker = *m_workers[index];
+	int		depth  = item.depth + 1;
+	int		count  = item.state.legalMoves(legalMoves);
+
+	worker.nodesExpanded++;
+
+	for (int i = 0; i < count; i++)
+	{
+		GameState child = item.state;
+		auto	  first = static_cast<std::uint32_t>(worker.moves.size());
+
+		child.apply(legalMoves[i]);
+		worker.moves.push_back(legalMoves[i]);
+		Solver::autoplay(child, worker.moves);
+
+		if (!m_visited->insert(child.canonicalHash()))
+		{
+			worker.moves.resize(first);
+			continue;
+		}
+
+		std::uint64_t node = (std::uint64_t(index) << 32) | worker.nodes.size();
+		worker.nodes.push_back({item.node, first, static_cast<std::uint8_t>(worker.moves.size() - first)});
+		worker.nodesGenerated++;
+
+		if (child.isWon())
+		{
+			stop(Solver::Result::Solved, node);
+			return;
+		}
+
+		worker.open.push_back({child, node, depth + Solver::heuristic(child), worker.sequence++, static_cast<std::uint16_t>(depth)});
+		std::push_heap(worker.open.begin(), worker.open.end(), isWorse<WorkItem>);
+	}
+}
+
+/*!
+ * \brief Get the next position to expand from the worker's own open list or deque
+ * \return false if the worker has nothing left
+ */
+bool ParallelSolver::take(Worker& worker, WorkItem& item)
+{
+	if (!worker.open.empty())
+	{
+		std::pop_heap(worker.open.begin(), worker.open.end(), isWorse<WorkItem>);
+		item = worker.open.back();
+		worker.open.pop_back();
+		return true;
+	}
+
+	std::lock_guard lock(worker.dequeMutex);
+	if (worker.deque.empty())
+	{
+		return false;
+	}
+	item = worker.deque.back();
+	worker.deque.pop_back();
+	return true;
+}
+
+/*!
+ * \brief Steal a position from the front of another worker's deque
+ * \param index The index of the thief
+ * \param item  Receives the stolen position
+ * \return true if a position was stolen
+ */
+bool ParallelSolver::steal(unsigned int index, WorkItem& item)
+{
+	for (unsigned int i = 1; i < m_threadCount; i++)
+	{
+		Worker&			victim = *m_workers[(index + i) % m_threadCount];
+		std::lock_guard lock(victim.dequeMutex);
+		if (!victim.deque.empty())
+		{
+			// count the thief as busy before the position leaves the deque, so that the
+			// search can't be considered exhausted in between
+			m_busy++;
+			item = victim.deque.front();
+			victim.deque.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+/*!
+ * \brief Hand over some of the worker's best positions to hungry workers
+ *
+ * The worker keeps its very best position, and moves the next ones to its deque.
+ */
+void ParallelSolver::share(Worker& worker)
+{
+	if (worker.open.size() < 2)
+	{
+		return;
+	}
+
+	std::lock_guard lock(worker.dequeMutex);
+	if (!worker.deque.empty())
+	{
+		return;
+	}
+
+	std::pop_heap(worker.open.begin(), worker.open.end(), isWorse<WorkItem>);
+	WorkItem best = worker.open.back();
+	worker.open.pop_back();
+
+	std::size_t count = std::min({SHARE_BATCH, static_cast<std::size_t>(m_hungry.load(std::memory_order_relaxed)), worker.open.size()});
+	for (std::size_t i = 0; i < count; i++)
+	{
+		std::pop_heap(worker.open.begin(), worker.open.end(), isWorse<WorkItem>);
+		worker.deque.push_back(worker.open.back());
+		worker.open.pop_back();
+	}
+
+	worker.open.push_back(best);
+	std::push_heap(worker.open.begin(), worker.open.end(), isWorse<WorkItem>);
+
+	if (count > 0)
+	{
+		m_offers.fetch_add(1, std::memory_order_release);
+		m_offers.notify_all();
+	}
+}
+
+/*!
+ * \brief Stop every worker
+ * \param result The outcome of the search. Only the first call is recorded.
+ * \param winner The won node, for Solved
+ */
+void ParallelSolver::stop(Solver::Result result, std::uint64_t winner)
+{
+	bool expected = false;
+	if (m_stop.compare_exchange_strong(expected, true))
+	{
+		// read by solve() once the threads are joined
+		m_result = result;
+		m_winner = winner;
+	}
+
+	// wake the idle workers, so that they see m_stop
+	m_offers.fetch_add(1, std::memory_order_release);
+	m_offers.notify_all();
+}
+
+/*!
+ * \brief Collect the moves leading from the root to a node, across the workers' node arenas
+ */
+void ParallelSolver::buildSolution(std::uint64_t node)
+{
+	m_solution.clear();
+	while (node != NO_NODE)
+	{
+		const Worker& worker = *m_workers[node >> 32];
+		const Node&	  n		 = worker.nodes[node & 0xFFFFFFFF];
+		for (int i = n.moveCount - 1; i >= 0; i--)
+		{
+			m_solution.push_back(worker.moves[n.firstMove + i]);
+		}
+		node = n.parent;
+	}
+	std::reverse(m_solution.begin(), m_solution.end());
+}
+
+/*!
+ * \brief Get the memory held by a worker, in bytes. Only the worker's own thread may call it while searching.
+ */
+std::size_t ParallelSolver::memoryUsage(const Worker& worker) noexcept
+{
+	return worker.nodes.capacity() * sizeof(Node) + worker.moves.capacity() * sizeof(StateMove) + worker.open.capacity() * sizeof(WorkItem);
+}
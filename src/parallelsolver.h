@@ -0,0 +1,120 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARALLELSOLVER_H
+#define PARALLELSOLVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "concurrenttranspositiontable.h"
+#include "solver.h"
+
+/*!
+ * \brief Multi-threaded variant of `Solver` for hard deals
+ *
+ * Every worker thread runs its own best-first search over a private open list, and all of them
+ * share a `ConcurrentTranspositionTable` so that no position is expanded twice. Work moves
+ * between threads through one work-stealing deque per worker: when some workers run dry, busy
+ * workers hand over their next best positions at the back of their deque, and idle workers
+ * steal from the front of the others' deques. Idle workers sleep until positions are shared
+ * rather than spin.
+ *
+ * The first worker to reach a won position stops all the others. The search is exhaustive
+ * (Unsolvable) once every worker is idle with all the deques empty.
+ */
+class ParallelSolver
+{
+public:
+
+	explicit ParallelSolver(unsigned int threadCount = 0, SolverLimits limits = {});
+
+	Solver::Result solve(const GameState& start);
+
+	[[nodiscard]] const std::vector<StateMove>& solution() const noexcept;
+	[[nodiscard]] const SolverStats&			stats() const noexcept;
+	[[nodiscard]] unsigned int					threadCount() const noexcept;
+
+protected:
+
+	static constexpr std::uint64_t NO_NODE = ~std::uint64_t(0);
+
+	struct Node
+	{
+		std::uint64_t parent;
+		std::uint32_t firstMove;
+		std::uint8_t  moveCount;
+	};
+
+	struct WorkItem
+	{
+		GameState	  state;
+		std::uint64_t node;
+		std::int32_t  priority;
+		std::uint32_t sequence;
+		std::uint16_t depth;
+	};
+
+	struct Worker
+	{
+		std::vector<Node>	   nodes;
+		std::vector<StateMove> moves;
+		std::vector<WorkItem>  open;
+
+		std::mutex			 dequeMutex;
+		std::deque<WorkItem> deque;
+
+		std::uint64_t nodesExpanded	 = 0;
+		std::uint64_t nodesGenerated = 0;
+		std::uint32_t sequence		 = 0;
+	};
+
+	void run(unsigned int index);
+	void expand(unsigned int index, const WorkItem& item, StateMove* legalMoves);
+	bool take(Worker& worker, WorkItem& item);
+	bool steal(unsigned int index, WorkItem& item);
+	void share(Worker& worker);
+	void stop(Solver::Result result, std::uint64_t winner = NO_NODE);
+
+	void				buildSolution(std::uint64_t node);
+	static std::size_t	memoryUsage(const Worker& worker) noexcept;
+
+protected:
+
+	unsigned int m_threadCount;
+	SolverLimits m_limits;
+	SolverStats	 m_stats;
+
+	std::vector<std::unique_ptr<Worker>>		  m_workers;
+	std::unique_ptr<ConcurrentTranspositionTable> m_visited;
+
+	std::atomic<bool>		   m_stop	  = false;
+	std::atomic<int>		   m_busy	  = 0;
+	std::atomic<int>		   m_hungry	  = 0;
+	std::atomic<std::uint64_t> m_expanded = 0;
+	std::atomic<std::uint32_t> m_offers	  = 0; //!< Bumped when positions are shared or the search stops, idle workers wait on it
+	Solver::Result			   m_result	  = Solver::Result::Unsolvable;
+	std::uint64_t			   m_winner	  = NO_NODE;
+
+	std::vector<StateMove> m_solution;
+};
+
+#endif // PARALLELSOLVER_H
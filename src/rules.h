@@ -0,0 +1,145 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RULES_H
+#define RULES_H
+
+#include <array>
+#include <cstdint>
+
+#include "cardid.h"
+
+/*!
+ * \file rules.h
+ * \brief Stacking rules of Freecell, as lookup tables keyed by card id
+ *
+ * The tables are computed at compile time. `Card`, the spots of the board and `GameState` all
+ * test legality through them, so that the UI and the solvers can't disagree, and a test on the
+ * hot path is a single load.
+ */
+
+using CardPairTable = std::array<std::array<bool, NB_CARDS>, NB_CARDS>;
+
+//! [parent][child]: the child goes on the parent in a column (value one lower, other color)
+inline constexpr CardPairTable TABLEAU_STACKING = []
+{
+	CardPairTable table{};
+	for (int parent = 0; parent < NB_CARDS; parent++)
+	{
+		for (int child = 0; child < NB_CARDS; child++)
+		{
+			table[parent][child] = cardValue(parent) - cardValue(child) == 1 && cardIsRed(parent) != cardIsRed(child);
+		}
+	}
+	return table;
+}();
+
+//! [top][card]: the card goes on the top card of a foundation (same suit, value one higher)
+inline constexpr CardPairTable FOUNDATION_STACKING = []
+{
+	CardPairTable table{};
+	for (int top = 0; top < NB_CARDS; top++)
+	{
+		for (int card = 0; card < NB_CARDS; card++)
+		{
+			table[top][card] = cardSuit(top) == cardSuit(card) && cardValue(card) - cardValue(top) == 1;
+		}
+	}
+	return table;
+}();
+
+//! [foundation][height]: the next card of a foundation holding `height` cards, NO_CARD once complete
+inline constexpr std::array<std::array<CardId, NB_VALUES + 1>, NB_SUITS> FOUNDATION_NEXT = []
+{
+	std::array<std::array<CardId, NB_VALUES + 1>, NB_SUITS> table{};
+	for (int foundation = 0; foundation < NB_SUITS; foundation++)
+	{
+		for (int height = 0; height < NB_VALUES; height++)
+		{
+			table[foundation][height] = cardId(foundation + 1, height + 1);
+		}
+		table[foundation][NB_VALUES] = NO_CARD;
+	}
+	return table;
+}();
+
+//! [card]: the foundation of the card, i.e. its suit - 1
+inline constexpr std::array<std::uint8_t, NB_CARDS> FOUNDATION_INDEX = []
+{
+	std::array<std::uint8_t, NB_CARDS> table{};
+	for (int card = 0; card < NB_CARDS; card++)
+	{
+		table[card] = static_cast<std::uint8_t>(cardSuit(card) - 1);
+	}
+	return table;
+}();
+
+//! [card]: the card may rest in a freecell. Aces never do, they go straight to the foundations.
+inline constexpr std::array<bool, NB_CARDS> FREECELL_ALLOWED = []
+{
+	std::array<bool, NB_CARDS> table{};
+	for (int card = 0; card < NB_CARDS; card++)
+	{
+		table[card] = cardValue(card) != VALUE_ACE;
+	}
+	return table;
+}();
+
+/*!
+ * \brief Check if `child` can be stacked over `parent` in a column
+ */
+constexpr bool canStackOnTableau(CardId parent, CardId child) noexcept
+{
+	return TABLEAU_STACKING[parent][child];
+}
+
+/*!
+ * \brief Check if `card` can be stacked over `top` on a foundation
+ */
+constexpr bool canStackOnFoundation(CardId top, CardId card) noexcept
+{
+	return FOUNDATION_STACKING[top][card];
+}
+
+/*!
+ * \brief Get the foundation (0..3) a card belongs to
+ */
+constexpr int foundationIndex(CardId card) noexcept
+{
+	return FOUNDATION_INDEX[card];
+}
+
+/*!
+ * \brief Check if a card is the next one of a foundation
+ * \param foundation The foundation (0..3)
+ * \param height     The number of cards on the foundation
+ * \param card       The card
+ */
+constexpr bool isNextOnFoundation(int foundation, int height, CardId card) noexcept
+{
+	return FOUNDATION_NEXT[foundation][height] == card;
+}
+
+/*!
+ * \brief Check if a card may be put in a freecell
+ */
+constexpr bool canGoToFreecell(CardId card) noexcept
+{
+	return FREECELL_ALLOWED[card];
+}
+
+#endif // RULES_H
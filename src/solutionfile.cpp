@@ -0,0 +1,318 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "solutionfile.h"
+
+#include <algorithm>
+#include <cstring>
+
+/*!
+ * \brief Get a move of the solution
+ * \param index The rank of the move, below moveCount
+ */
+StateMove SolutionRecord::move(int index) const noexcept
+{
+	return JournalEntry{moves[2 * index], moves[2 * index + 1]}.move();
+}
+
+/*!
+ * \brief Constructor
+ * \param position The first record
+ * \param end      The end of the records, i.e. the start of the block index
+ * \param count    The number of records from the first one
+ */
+SolutionFile::Iterator::Iterator(const std::uint8_t* position, const std::uint8_t* end, std::uint32_t count) noexcept
+	: m_position(position)
+	, m_end(end)
+	, m_left(count)
+{
+	decode();
+}
+
+SolutionFile::Iterator& SolutionFile::Iterator::operator++() noexcept
+{
+	m_position += RECORD_HEADER_SIZE + 2 * std::size_t(m_record.moveCount);
+	m_left--;
+	decode();
+	return *this;
+}
+
+SolutionFile::Iterator SolutionFile::Iterator::operator++(int) noexcept
+{
+	Iterator previous = *this;
+	++*this;
+	return previous;
+}
+
+/*!
+ * \brief Decode the record at the current position, or move to the end after the last record or a truncated one
+ */
+void SolutionFile::Iterator::decode() noexcept
+{
+	std::size_t left = static_cast<std::size_t>(m_end - m_position);
+	if (m_left == 0 || left < RECORD_HEADER_SIZE)
+	{
+		m_position = m_end;
+		return;
+	}
+
+	std::memcpy(&m_record.gameNumber, m_position, sizeof(m_record.gameNumber));
+	std::memcpy(&m_record.moveCount, m_position + sizeof(m_record.gameNumber), sizeof(m_record.moveCount));
+	m_record.moves = m_position + RECORD_HEADER_SIZE;
+	if (left < RECORD_HEADER_SIZE + 2 * std::size_t(m_record.moveCount))
+	{
+		m_position = m_end;
+	}
+}
+
+/*!
+ * \brief Constructor
+ *
+ * The view is left invalid if the bytes don't hold a complete solution file of the current
+ * format and deal generator.
+ *
+ * \param data The content of a solution file. It must outlive the view.
+ * \param size The size of the content, in bytes
+ */
+SolutionFile::SolutionFile(const std::uint8_t* data, std::size_t size) noexcept
+{
+	if (!data || size < sizeof(SolutionFileHeader))
+	{
+		return;
+	}
+
+	const auto* header = reinterpret_cast<const SolutionFileHeader*>(data);
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+		header->generatorVersion != GameState::DEAL_GENERATOR_VERSION)
+	{
+		return;
+	}
+
+	// the index is written last, and must cover every record
+	std::uint64_t offset = header->indexOffset;
+	if (offset < sizeof(SolutionFileHeader) || offset % alignof(SolutionBlock) != 0 || offset > size ||
+		(size - offset) / sizeof(SolutionBlock) < header->blockCount ||
+		header->blockCount != (std::uint64_t(header->count) + BLOCK_SIZE - 1) / BLOCK_SIZE)
+	{
+		return;
+	}
+
+	m_data	 = data;
+	m_header = header;
+	m_blocks = reinterpret_cast<const SolutionBlock*>(data + offset);
+}
+
+bool SolutionFile::isValid() const noexcept
+{
+	return m_header != nullptr;
+}
+
+std::uint32_t SolutionFile::count() const noexcept
+{
+	return m_header ? m_header->count : 0;
+}
+
+SolutionFile::Iterator SolutionFile::begin() const noexcept
+{
+	if (!m_header)
+	{
+		return {};
+	}
+	return Iterator(m_data + sizeof(SolutionFileHeader), m_data + m_header->indexOffset, m_header->count);
+}
+
+SolutionFile::Iterator SolutionFile::end() const noexcept
+{
+	if (!m_header)
+	{
+		return {};
+	}
+	return Iterator(m_data + m_header->indexOffset, m_data + m_header->indexOffset, 0);
+}
+
+/*!
+ * \brief Get an iterator on the first record of a block, to walk a part of the file
+ * \param block The block, below (count() + BLOCK_SIZE - 1) / BLOCK_SIZE
+ */
+SolutionFile::Iterator SolutionFile::blockBegin(std::uint32_t block) const noexcept
+{
+	if (!m_header || block >= m_header->blockCount || m_blocks[block].offset < sizeof(SolutionFileHeader) ||
+		m_blocks[block].offset > m_header->indexOffset || m_blocks[block].firstRecord >= m_header->count)
+	{
+		return end();
+	}
+	return Iterator(m_data + m_blocks[block].offset, m_data + m_header->indexOffset, m_header->count - m_blocks[block].firstRecord);
+}
+
+/*!
+ * \brief Look up the solution of a game
+ * \param record Receives the solution
+ * \return false if the file has no solution for the game
+ */
+bool SolutionFile::find(std::uint32_t gameNumber, SolutionRecord& record) const noexcept
+{
+	if (!m_header || m_header->blockCount == 0)
+	{
+		return false;
+	}
+
+	const SolutionBlock* blocks = m_blocks;
+	const SolutionBlock* next	= std::upper_bound(blocks, blocks + m_header->blockCount, gameNumber,
+												   [](std::uint32_t game, const SolutionBlock& block) { return game < block.firstGame; });
+	if (next == blocks)
+	{
+		return false;
+	}
+
+	Iterator it = blockBegin(static_cast<std::uint32_t>(next - 1 - blocks));
+	for (std::uint32_t i = 0; i < BLOCK_SIZE && it != end() && it->gameNumber <= gameNumber; i++, ++it)
+	{
+		if (it->gameNumber == gameNumber)
+		{
+			record = *it;
+			return true;
+		}
+	}
+	return false;
+}
+
+/*!
+ * \brief Constructor
+ * \param bufferSize The number of bytes buffered before they are written to the file
+ */
+SolutionWriter::SolutionWriter(std::size_t bufferSize)
+	: m_bufferSize(std::max(bufferSize, sizeof(SolutionFileHeader)))
+{
+	m_buffer.reserve(m_bufferSize);
+}
+
+SolutionWriter::~SolutionWriter()
+{
+	close();
+}
+
+/*!
+ * \brief Create a solution file, closing the previous one
+ * \return false if the file can't be created
+ */
+bool SolutionWriter::open(const char* path)
+{
+	close();
+
+	m_file.clear();
+	m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	m_buffer.assign(sizeof(SolutionFileHeader), 0);
+	m_offset   = 0;
+	m_count	   = 0;
+	m_lastGame = 0;
+	m_failed   = !m_file;
+	m_blocks.clear();
+	return !m_failed;
+}
+
+/*!
+ * \brief Append the solution of a game
+ * \param gameNumber The game number, greater than the one of the previous solution
+ * \param moves      The moves of the solution
+ * \param count      The number of moves, up to 65535
+ * \return false if the solution can't be added
+ */
+bool SolutionWriter::add(std::uint32_t gameNumber, const StateMove* moves, std::size_t count)
+{
+	if (!m_file.is_open() || m_failed || (m_count > 0 && gameNumber <= m_lastGame) || count > UINT16_MAX)
+	{
+		return false;
+	}
+
+	std::size_t size = SolutionFile::RECORD_HEADER_SIZE + 2 * count;
+	if (m_buffer.size() + size > m_bufferSize && !flush())
+	{
+		return false;
+	}
+	if (m_count % SolutionFile::BLOCK_SIZE == 0)
+	{
+		m_blocks.push_back({gameNumber, m_count, m_offset + m_buffer.size()});
+	}
+
+	std::size_t	  start		= m_buffer.size();
+	std::uint16_t moveCount = static_cast<std::uint16_t>(count);
+	m_buffer.resize(start + size);
+	std::uint8_t* bytes = m_buffer.data() + start;
+	std::memcpy(bytes, &gameNumber, sizeof(gameNumber));
+	std::memcpy(bytes + sizeof(gameNumber), &moveCount, sizeof(moveCount));
+	bytes += SolutionFile::RECORD_HEADER_SIZE;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		JournalEntry entry = JournalEntry::fromMove(moves[i]);
+		*bytes++		   = entry.fromTo;
+		*bytes++		   = entry.count;
+	}
+
+	m_count++;
+	m_lastGame = gameNumber;
+	return true;
+}
+
+/*!
+ * \brief Write the block index and the final header, and close the file
+ * \return false if any write failed
+ */
+bool SolutionWriter::close()
+{
+	if (!m_file.is_open())
+	{
+		return !m_failed;
+	}
+
+	// the index is aligned for SolutionFile to read it in place
+	std::uint64_t indexOffset = m_offset + m_buffer.size();
+	indexOffset				  = (indexOffset + alignof(SolutionBlock) - 1) / alignof(SolutionBlock) * alignof(SolutionBlock);
+	m_buffer.resize(indexOffset - m_offset, 0);
+	flush();
+	m_file.write(reinterpret_cast<const char*>(m_blocks.data()), static_cast<std::streamsize>(m_blocks.size() * sizeof(SolutionBlock)));
+
+	SolutionFileHeader header{};
+	std::memcpy(header.magic, SolutionFile::MAGIC, sizeof(SolutionFile::MAGIC));
+	header.version			= SolutionFile::VERSION;
+	header.generatorVersion = GameState::DEAL_GENERATOR_VERSION;
+	header.count			= m_count;
+	header.blockCount		= static_cast<std::uint32_t>(m_blocks.size());
+	header.indexOffset		= indexOffset;
+	m_file.seekp(0);
+	m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	m_file.close();
+	m_failed = m_failed || !m_file;
+	return !m_failed;
+}
+
+/*!
+ * \brief Get the number of solutions added so far
+ */
+std::uint32_t SolutionWriter::count() const noexcept
+{
+	return m_count;
+}
+
+bool SolutionWriter::flush()
+{
+	m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	m_offset += m_buffer.size();
+	m_buffer.clear();
+	m_failed = m_failed || !m_file;
+	return !m_failed;
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOLUTIONFILE_H
+#define SOLUTIONFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "gamestate.h"
+#include "movejournal.h"
+
+/*!
+ * \brief Header of a solution file
+ *
+ * The header is followed by the records, one per deal in increasing game number order, then by
+ * the block index. A record is the game number (4 bytes), the number of moves (2 bytes) and the
+ * moves, packed as `JournalEntry`. The block index holds a `SolutionBlock` for every BLOCK_SIZE
+ * records. Integers are stored in the native byte order of the machine that wrote the file, as
+ * the file is read in place; the text notation is the portable form.
+ *
+ * indexOffset stays 0 until the writer is closed, so that an interrupted write is not mistaken
+ * for a complete file.
+ */
+struct SolutionFileHeader
+{
+	char		  magic[8];			//!< SolutionFile::MAGIC
+	std::uint32_t version;			//!< SolutionFile::VERSION
+	std::uint32_t generatorVersion; //!< GameState::DEAL_GENERATOR_VERSION of the solved deals
+	std::uint32_t count;			//!< Number of records
+	std::uint32_t blockCount;		//!< Number of entries of the block index
+	std::uint64_t indexOffset;		//!< Offset of the block index from the start of the file
+};
+
+static_assert(sizeof(SolutionFileHeader) == 32);
+
+/*!
+ * \brief Entry of the block index of a solution file
+ */
+struct SolutionBlock
+{
+	std::uint32_t firstGame;   //!< Game number of the first record of the block
+	std::uint32_t firstRecord; //!< Rank of the first record of the block in the file
+	std::uint64_t offset;	   //!< Offset of the first record of the block from the start of the file
+};
+
+static_assert(sizeof(SolutionBlock) == 16);
+
+/*!
+ * \brief Solution of a deal, pointing into the bytes of a solution file
+ */
+struct SolutionRecord
+{
+	std::uint32_t		gameNumber = 0;
+	std::uint16_t		moveCount  = 0;
+	const std::uint8_t* moves	   = nullptr; //!< moveCount packed `JournalEntry`
+
+	[[nodiscard]] StateMove move(int index) const noexcept;
+};
+
+/*!
+ * \brief Read-only view over a solution file
+ *
+ * The records are decoded in place as they are iterated, so that a memory-mapped file of
+ * millions of solutions is walked without any allocation. find() reaches the record of a game
+ * number with a binary search in the block index, then a scan of at most BLOCK_SIZE records.
+ *
+ * The view does not own its bytes, and stops at the first record that would overrun them.
+ */
+class SolutionFile
+{
+public:
+
+	static constexpr char		   MAGIC[8]	  = {'F', 'C', 'S', 'O', 'L', 'U', 'T', 'N'};
+	static constexpr std::uint32_t VERSION	  = 1;
+	static constexpr std::uint32_t BLOCK_SIZE = 64;
+
+	static constexpr std::size_t RECORD_HEADER_SIZE = 6;
+
+	/*!
+	 * \brief Forward iterator over the records of the file
+	 */
+	class Iterator
+	{
+	public:
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type		= SolutionRecord;
+		using difference_type	= std::ptrdiff_t;
+		using pointer			= const SolutionRecord*;
+		using reference			= const SolutionRecord&;
+
+		Iterator() = default;
+		Iterator(const std::uint8_t* position, const std::uint8_t* end, std::uint32_t count) noexcept;
+
+		reference operator*() const noexcept
+		{
+			return m_record;
+		}
+		pointer operator->() const noexcept
+		{
+			return &m_record;
+		}
+		Iterator& operator++() noexcept;
+		Iterator  operator++(int) noexcept;
+		bool	  operator==(const Iterator& other) const noexcept
+		{
+			return m_position == other.m_position;
+		}
+
+	protected:
+
+		void decode() noexcept;
+
+	protected:
+
+		const std::uint8_t* m_position = nullptr;
+		const std::uint8_t* m_end	   = nullptr;
+		std::uint32_t		m_left	   = 0; //!< Records left from the current one
+		SolutionRecord		m_record;
+	};
+
+public:
+
+	SolutionFile() = default;
+	SolutionFile(const std::uint8_t* data, std::size_t size) noexcept;
+
+	[[nodiscard]] bool			isValid() const noexcept;
+	[[nodiscard]] std::uint32_t count() const noexcept;
+
+	[[nodiscard]] Iterator begin() const noexcept;
+	[[nodiscard]] Iterator end() const noexcept;
+	[[nodiscard]] Iterator blockBegin(std::uint32_t block) const noexcept;
+
+	bool find(std::uint32_t gameNumber, SolutionRecord& record) const noexcept;
+
+protected:
+
+	const std::uint8_t*		  m_data   = nullptr;
+	const SolutionFileHeader* m_header = nullptr;
+	const SolutionBlock*	  m_blocks = nullptr;
+};
+
+/*!
+ * \brief Streaming writer of a solution file
+ *
+ * Records are encoded into a buffer of fixed size, written out whenever it fills up. Besides
+ * that buffer, the writer only keeps the block index, i.e. 16 bytes every BLOCK_SIZE deals.
+ */
+class SolutionWriter
+{
+public:
+
+	static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t(1) << 20;
+
+public:
+
+	explicit SolutionWriter(std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+	~SolutionWriter();
+
+	bool open(const char* path);
+	bool add(std::uint32_t gameNumber, const StateMove* moves, std::size_t count);
+	bool close();
+
+	[[nodiscard]] std::uint32_t count() const noexcept;
+
+protected:
+
+	bool flush();
+
+protected:
+
+	std::ofstream			   m_file;
+	std::vector<std::uint8_t>  m_buffer;
+	std::size_t				   m_bufferSize;
+	std::uint64_t			   m_offset = 0; //!< Offset of the start of the buffer in the file
+	std::vector<SolutionBlock> m_blocks;
+	std::uint32_t			   m_count	  = 0;
+	std::uint32_t			   m_lastGame = 0;
+	bool					   m_failed	  = false;
+};
+
+#endif // SOLUTIONFILE_H
@@ -0,0 +1,255 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "solver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include "autoplay.h"
+
+namespace
+{
+	constexpr std::uint32_t NO_NODE = 0xFFFFFFFF;
+
+	/*!
+	 * \brief Sort key of the open list: lowest priority first, then most recent node first
+	 */
+	constexpr std::uint64_t openKey(int priority, std::uint32_t node) noexcept
+	{
+		return (std::uint64_t(priority) << 32) | (NO_NODE - node);
+	}
+
+	constexpr std::uint32_t openNode(std::uint64_t key) noexcept
+	{
+		return NO_NODE - static_cast<std::uint32_t>(key);
+	}
+} // namespace
+
+double SolverStats::statesPerSecond() const noexcept
+{
+	return seconds > 0.0 ? nodesExpanded / seconds : 0.0;
+}
+
+/*!
+ * \brief Constructor
+ * \param limits The budget of each search
+ */
+Solver::Solver(SolverLimits limits)
+	: m_limits(limits)
+{
+}
+
+/*!
+ * \brief Search a winning sequence of moves
+ * \param start     The position to solve
+ * \param stopToken Cancels the search from another thread, checked every 256 positions
+ * \param goal      Positions known to lead to a win, where the search stops too
+ * \return Solved if solution() holds a winning sequence, or a sequence reaching a goal position
+ */
+Solver::Result Solver::solve(const GameState& start, std::stop_token stopToken, const Goal& goal)
+{
+	auto startTime = std::chrono::steady_clock::now();
+
+	m_stats = {};
+	m_nodes.clear();
+	m_moves.clear();
+	m_open.clear();
+	m_visited.clear();
+	m_solution.clear();
+
+	auto finish = [&](Result result)
+	{
+		m_stats.seconds	   = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		m_stats.peakMemory = std::max(m_stats.peakMemory, memoryUsage());
+		return result;
+	};
+
+	GameState root = start;
+	autoplay(root, m_moves);
+	m_nodes.push_back({root, NO_NODE, 0, 0, static_cast<std::uint8_t>(m_moves.size())});
+	m_visited.insert(root.canonicalHash());
+
+	if (root.isWon() || (goal && goal(root)))
+	{
+		buildSolution(0);
+		return finish(Result::Solved);
+	}
+
+	m_open.push_back(openKey(0, 0));
+
+	StateMove legalMoves[GameState::MAX_MOVES];
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end(), std::greater<>());
+		std::uint32_t index = openNode(m_open.back());
+		m_open.pop_back();
+
+		if (m_stats.nodesExpanded >= m_limits.maxNodes)
+		{
+			return finish(Result::NodeLimit);
+		}
+		if ((m_stats.nodesExpanded & 0xFF) == 0)
+		{
+			if (stopToken.stop_requested())
+			{
+				return finish(Result::Cancelled);
+			}
+
+			std::size_t memory = memoryUsage();
+			m_stats.peakMemory = std::max(m_stats.peakMemory, memory);
+			if (memory > m_limits.maxMemory)
+			{
+				return finish(Result::MemoryLimit);
+			}
+		}
+		m_stats.nodesExpanded++;
+
+		// copied, m_nodes may reallocate below
+		GameState state = m_nodes[index].state;
+		int		  depth = m_nodes[index].depth + 1;
+		int		  count = state.legalMoves(legalMoves);
+
+		for (int i = 0; i < count; i++)
+		{
+			GameState child = state;
+			auto	  first = static_cast<std::uint32_t>(m_moves.size());
+
+			child.apply(legalMoves[i]);
+			m_moves.push_back(legalMoves[i]);
+			autoplay(child, m_moves);
+
+			if (!m_visited.insert(child.canonicalHash()))
+			{
+				m_moves.resize(first);
+				continue;
+			}
+
+			auto node = static_cast<std::uint32_t>(m_nodes.size());
+			m_nodes.push_back({child, index, first, static_cast<std::uint16_t>(depth), static_cast<std::uint8_t>(m_moves.size() - first)});
+			m_stats.nodesGenerated++;
+
+			if (child.isWon() || (goal && goal(child)))
+			{
+				buildSolution(node);
+				return finish(Result::Solved);
+			}
+
+			m_open.push_back(openKey(depth + heuristic(child), node));
+			std::push_heap(m_open.begin(), m_open.end(), std::greater<>());
+		}
+	}
+
+	return finish(Result::Unsolvable);
+}
+
+/*!
+ * \brief Get the winning moves found by the last successful search
+ */
+const std::vector<StateMove>& Solver::solution() const noexcept
+{
+	return m_solution;
+}
+
+const SolverStats& Solver::stats() const noexcept
+{
+	return m_stats;
+}
+
+/*!
+ * \brief Move every card that is safe to put on the foundations
+ * \param state The position to update
+ * \param moves Receives the moves played
+ */
+void Solver::autoplay(GameState& state, std::vector<StateMove>& moves)
+{
+	Autoplay(Autoplay::Mode::Safe).run(state, moves);
+}
+
+/*!
+ * \brief Estimate the work left to win a position
+ *
+ * Cards away from the foundations, cards lying over a lower card of their column, and busy
+ * freecells cost; empty columns help.
+ */
+int Solver::heuristic(const GameState& state) noexcept
+{
+	int blockers = 0;
+	for (int column = 0; column < GameState::NB_COLUMNS; column++)
+	{
+		int lowest = VALUE_KING + 1;
+		for (int i = 0; i < state.columnSize(column); i++)
+		{
+			int value = cardValue(state.columnCard(column, i));
+			if (value > lowest)
+			{
+				blockers++;
+			}
+			else
+			{
+				lowest = value;
+			}
+		}
+	}
+
+	int busyFreecells = GameState::NB_FREECELLS - state.countFreeCells();
+	return 5 * (NB_CARDS - state.cardsOnFoundations()) + 3 * blockers + 4 * busyFreecells - 4 * state.countEmptyColumns();
+}
+
+const char* Solver::resultName(Result result) noexcept
+{
+	switch (result)
+	{
+		case Result::Solved:
+			return "solved";
+		case Result::Unsolvable:
+			return "unsolvable";
+		case Result::NodeLimit:
+			return "node limit reached";
+		case Result::MemoryLimit:
+			return "memory limit reached";
+		case Result::Cancelled:
+			return "cancelled";
+	}
+	return "";
+}
+
+/*!
+ * \brief Collect the moves leading from the root to a node
+ */
+void Solver::buildSolution(std::uint32_t node)
+{
+	m_solution.clear();
+	for (; node != NO_NODE; node = m_nodes[node].parent)
+	{
+		const Node& n = m_nodes[node];
+		for (int i = n.moveCount - 1; i >= 0; i--)
+		{
+			m_solution.push_back(m_moves[n.firstMove + i]);
+		}
+	}
+	std::reverse(m_solution.begin(), m_solution.end());
+}
+
+/*!
+ * \brief Get the memory held by the search structures, in bytes
+ */
+std::size_t Solver::memoryUsage() const noexcept
+{
+	return m_nodes.capacity() * sizeof(Node) + m_moves.capacity() * sizeof(StateMove) + m_open.capacity() * sizeof(std::uint64_t) + m_visited.memoryUsage();
+}
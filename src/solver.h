@@ -0,0 +1,120 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <vector>
+
+#include "gamestate.h"
+#include "transpositiontable.h"
+
+/*!
+ * \brief Budget of a search
+ */
+struct SolverLimits
+{
+	std::size_t maxNodes  = 2'000'000; //!< Maximum number of expanded positions
+	std::size_t maxMemory = 512 << 20; //!< Maximum memory held by the search, in bytes
+};
+
+/*!
+ * \brief Statistics of the last search
+ */
+struct SolverStats
+{
+	std::uint64_t nodesExpanded	 = 0;
+	std::uint64_t nodesGenerated = 0;
+	double		  seconds		 = 0.0;
+	std::size_t	  peakMemory	 = 0; //!< Peak memory held by the search, in bytes
+
+	[[nodiscard]] double statesPerSecond() const noexcept;
+};
+
+/*!
+ * \brief Best-first Freecell solver
+ *
+ * A weighted A* search over `GameState` positions: the open list is ordered by the number of
+ * moves played plus a heuristic estimate of the remaining work, and every generated position
+ * is recorded in a transposition table keyed by GameState::canonicalHash() so that it is only
+ * expanded once. Cards that are safe to put on the foundations are moved there automatically
+ * after each move, and those moves are part of the solution.
+ *
+ * A search may be given a goal besides the won position: positions already known to lead to a
+ * win, where the search can stop and leave the rest of the solution to the caller.
+ */
+class Solver
+{
+public:
+
+	enum class Result
+	{
+		Solved,
+		Unsolvable,
+		NodeLimit,
+		MemoryLimit,
+		Cancelled,
+	};
+
+	//! Tells if a position is known to lead to a win
+	using Goal = std::function<bool(const GameState&)>;
+
+public:
+
+	explicit Solver(SolverLimits limits = {});
+
+	Result solve(const GameState& start, std::stop_token stopToken = {}, const Goal& goal = {});
+
+	[[nodiscard]] const std::vector<StateMove>& solution() const noexcept;
+	[[nodiscard]] const SolverStats&			stats() const noexcept;
+
+	static void		   autoplay(GameState& state, std::vector<StateMove>& moves);
+	static int		   heuristic(const GameState& state) noexcept;
+	static const char* resultName(Result result) noexcept;
+
+protected:
+
+	struct Node
+	{
+		GameState	  state;
+		std::uint32_t parent;
+		std::uint32_t firstMove;
+		std::uint16_t depth;
+		std::uint8_t  moveCount;
+	};
+
+	void		buildSolution(std::uint32_t node);
+	std::size_t memoryUsage() const noexcept;
+
+protected:
+
+	SolverLimits m_limits;
+	SolverStats	 m_stats;
+
+	std::vector<Node>		   m_nodes;
+	std::vector<StateMove>	   m_moves;
+	std::vector<std::uint64_t> m_open;
+	TranspositionTable		   m_visited;
+
+	std::vector<StateMove> m_solution;
+};
+
+#endif // SOLVER_H
@@ -0,0 +1,207 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "solversession.h"
+
+namespace
+{
+	/*!
+	 * \brief Find the slot of a position matching a slot of another position with the same canonical hash
+	 *
+	 * Foundations match themselves. Other slots match the slot holding the same bottom card, and
+	 * empty slots match the empty slots of the same kind, in order.
+	 * \return The slot, -1 if the positions don't match
+	 */
+	int translateSlot(const GameState& from, const GameState& to, int slot) noexcept
+	{
+		if (GameState::isFoundation(slot))
+		{
+			return slot;
+		}
+
+		int first = GameState::isColumn(slot) ? GameState::FIRST_COLUMN : GameState::FIRST_FREECELL;
+		int count = GameState::isColumn(slot) ? GameState::NB_COLUMNS : GameState::NB_FREECELLS;
+
+		auto bottomCard = [](const GameState& state, int slot)
+		{
+			if (GameState::isColumn(slot))
+			{
+				return state.columnSize(slot) ? state.columnCard(slot, 0) : NO_CARD;
+			}
+			return state.freecell(slot - GameState::FIRST_FREECELL);
+		};
+
+		CardId card = bottomCard(from, slot);
+		int	   rank = 0;
+		if (card == NO_CARD)
+		{
+			for (int other = first; other < slot; other++)
+			{
+				rank += bottomCard(from, other) == NO_CARD;
+			}
+		}
+
+		for (int other = first; other < first + count; other++)
+		{
+			if (bottomCard(to, other) == card && (card != NO_CARD || rank-- == 0))
+			{
+				return other;
+			}
+		}
+		return -1;
+	}
+} // namespace
+
+/*!
+ * \brief Constructor
+ * \param limits The budget of each search
+ */
+SolverSession::SolverSession(SolverLimits limits)
+	: m_solver(limits)
+{
+}
+
+/*!
+ * \brief Start following a new game, forgetting the solutions of the previous one
+ * \param start The position of the new game
+ */
+void SolverSession::reset(const GameState& start)
+{
+	m_position = start;
+	m_known.clear();
+}
+
+/*!
+ * \brief Follow a move of the game
+ * \param move A legal move of the current position
+ */
+void SolverSession::play(StateMove move)
+{
+	m_position.apply(move);
+}
+
+/*!
+ * \brief Catch up with the game if it went to a position the session wasn't told about
+ *
+ * The solutions found so far are kept: they still apply if the game comes back to them.
+ */
+void SolverSession::sync(const GameState& state)
+{
+	if (!(m_position == state))
+	{
+		m_position = state;
+	}
+}
+
+/*!
+ * \brief Get a move leading to a win from the current position
+ *
+ * The move comes from a previous solution if the position is part of one. Otherwise a search
+ * looks for a way to win or to join a previous solution.
+ * \param stopToken Cancels the search
+ * \return The move, invalid if the search failed or was cancelled. lastResult() tells why.
+ */
+StateMove SolverSession::hint(std::stop_token stopToken)
+{
+	if (auto move = nextMove(m_position); move.isValid())
+	{
+		m_lastResult = Solver::Result::Solved;
+		return move;
+	}
+
+	if (m_known.size() >= MAX_POSITIONS)
+	{
+		m_known.clear();
+	}
+
+	m_lastResult = m_solver.solve(m_position, stopToken, [this](const GameState& state) { return m_known.contains(state.canonicalHash()); });
+	if (m_lastResult != Solver::Result::Solved)
+	{
+		return {};
+	}
+
+	learn(m_position, m_solver.solution());
+	return nextMove(m_position);
+}
+
+/*!
+ * \brief Get the outcome of the last call to hint()
+ */
+Solver::Result SolverSession::lastResult() const noexcept
+{
+	return m_lastResult;
+}
+
+/*!
+ * \brief Get the solver, whose statistics describe the last search
+ */
+const Solver& SolverSession::solver() const noexcept
+{
+	return m_solver;
+}
+
+const GameState& SolverSession::position() const noexcept
+{
+	return m_position;
+}
+
+/*!
+ * \brief Get the number of positions whose winning move is known
+ */
+std::size_t SolverSession::knownPositions() const noexcept
+{
+	return m_known.size();
+}
+
+/*!
+ * \brief Get the move of a previous solution from a position
+ * \return The move in the slots of the position, invalid if the position isn't part of a solution
+ */
+StateMove SolverSession::nextMove(const GameState& state) const
+{
+	auto it = m_known.find(state.canonicalHash());
+	if (it == m_known.end())
+	{
+		return {};
+	}
+
+	const Known& known = it->second;
+	int			 from  = translateSlot(known.position, state, known.next.from);
+	int			 to	   = translateSlot(known.position, state, known.next.to);
+	if (from < 0 || to < 0)
+	{
+		return {};
+	}
+
+	// guards against hash collisions
+	StateMove move = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), known.next.count};
+	return state.isLegal(move) ? move : StateMove();
+}
+
+/*!
+ * \brief Remember the positions of a solution and the move played from each of them
+ * \param state The position the solution starts from
+ * \param moves The moves, leading to a win or to a position already known
+ */
+void SolverSession::learn(GameState state, const std::vector<StateMove>& moves)
+{
+	for (auto move : moves)
+	{
+		m_known.try_emplace(state.canonicalHash(), Known{state, move});
+		state.apply(move);
+	}
+}
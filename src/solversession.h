@@ -0,0 +1,82 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOLVERSESSION_H
+#define SOLVERSESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+#include <unordered_map>
+#include <vector>
+
+#include "gamestate.h"
+#include "solver.h"
+
+/*!
+ * \brief Solver bound to a game in progress, remembering what its searches found
+ *
+ * The session follows the moves of the game with play(), and keeps every position of the
+ * solutions it found along with the move to play from there. While the player follows a
+ * solution, or comes back to it, the next move is known without searching. Otherwise a new
+ * search stops as soon as it reaches a position of a previous solution.
+ *
+ * Positions are matched by their canonical hash: the moves of a solution are translated to the
+ * columns and freecells of the actual position.
+ */
+class SolverSession
+{
+public:
+
+	//! Number of positions remembered before the session starts afresh
+	static constexpr std::size_t MAX_POSITIONS = 1 << 16;
+
+public:
+
+	explicit SolverSession(SolverLimits limits = {});
+
+	void reset(const GameState& start);
+	void play(StateMove move);
+	void sync(const GameState& state);
+
+	StateMove hint(std::stop_token stopToken = {});
+
+	[[nodiscard]] Solver::Result   lastResult() const noexcept;
+	[[nodiscard]] const Solver&	   solver() const noexcept;
+	[[nodiscard]] const GameState& position() const noexcept;
+	[[nodiscard]] std::size_t	   knownPositions() const noexcept;
+
+protected:
+
+	struct Known
+	{
+		GameState position;
+		StateMove next; //!< The move to play from the position, in its own slots
+	};
+
+	StateMove nextMove(const GameState& state) const;
+	void	  learn(GameState state, const std::vector<StateMove>& moves);
+
+protected:
+
+	Solver									 m_solver;
+	Solver::Result							 m_lastResult = Solver::Result::Unsolvable;
+	GameState								 m_position;
+	std::unordered_map<std::uint64_t, Known> m_known;
+};
+
+#endif // SOLVERSESSION_H
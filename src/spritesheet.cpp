@@ -0,0 +1,160 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spritesheet.h"
+
+#include <QFile>
+#include <QPainter>
+#include <QPainterPath>
+
+#include <cstring>
+
+/*!
+ * \brief Get the tile of a card face
+ * \param value The value, as Card::Value
+ * \param suit  The suit, as Card::Suit
+ */
+int SpriteSheet::faceTile(int value, int suit) noexcept
+{
+	return (suit - 1) * NB_COLUMNS + value - 1;
+}
+
+/*!
+ * \brief Check if a tile holds a card, the last column only holds the back
+ */
+bool SpriteSheet::isUsed(int tile) noexcept
+{
+	return tile == BACK_TILE || tile % NB_COLUMNS != NB_COLUMNS - 1;
+}
+
+/*!
+ * \brief Get the name of the image of a tile in resources/cards
+ */
+QString SpriteSheet::imageName(int tile)
+{
+	static const char* const suits[]  = {"clubs", "diamonds", "hearts", "spades"};
+	static const char* const values[] = {"ace", "2", "3", "4", "5", "6", "7", "8", "9", "10", "jack", "queen", "king"};
+
+	if (tile == BACK_TILE)
+		return "back.png";
+	return QString("%1_of_%2.png").arg(values[tile % NB_COLUMNS], suits[tile / NB_COLUMNS]);
+}
+
+/*!
+ * \brief Get the size of a tile from its width, keeping the proportions of the cards
+ */
+QSize SpriteSheet::tileSize(int tileWidth) noexcept
+{
+	return {tileWidth, qRound(tileWidth * qreal(CARD_HEIGHT) / CARD_WIDTH)};
+}
+
+QRect SpriteSheet::tileRect(QSize tileSize, int tile) noexcept
+{
+	return {QPoint(tile % NB_COLUMNS * tileSize.width(), tile / NB_COLUMNS * tileSize.height()), tileSize};
+}
+
+/*!
+ * \brief Render a card in a tile: the paper clipped to the rounded corners, the image within the
+ * margins and a 1px border, all scaled from the size of the cards to the size of the tile
+ */
+void SpriteSheet::renderTile(QPainter& painter, const QRect& target, const QImage& paper, const QImage& face)
+{
+	painter.save();
+	painter.setRenderHint(QPainter::Antialiasing, true);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+	painter.translate(target.topLeft());
+	painter.scale(qreal(target.width()) / CARD_WIDTH, qreal(target.height()) / CARD_HEIGHT);
+
+	QRectF		 card(0, 0, CARD_WIDTH, CARD_HEIGHT);
+	QPainterPath path;
+	path.addRoundedRect(card.adjusted(0.5, 0.5, -0.5, -0.5), BORDER_RADIUS, BORDER_RADIUS);
+	painter.setClipPath(path);
+
+	// the paper is tiled from the corner of each card
+	if (paper.isNull())
+		painter.fillPath(path, Qt::white);
+	else
+		painter.fillPath(path, QBrush(paper));
+
+	if (!face.isNull())
+		painter.drawImage(card.adjusted(MARGIN, MARGIN, -MARGIN, -MARGIN), face, face.rect());
+
+	painter.setPen(QPen(Qt::darkGray, 1));
+	painter.drawPath(path);
+	painter.restore();
+}
+
+/*!
+ * \brief Write a sheet of tiles
+ * \param sheet     The rendered tiles, NB_COLUMNS by NB_ROWS of them
+ * \param tileWidth The width of a tile
+ * \param path      The file to write
+ * \return false if the file can't be written
+ */
+bool SpriteSheet::save(const QImage& sheet, int tileWidth, const QString& path)
+{
+	QImage pixels = sheet.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+	SpriteSheetHeader header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+	header.version		= VERSION;
+	header.tileWidth	= tileWidth;
+	header.tileHeight	= tileSize(tileWidth).height();
+	header.bytesPerLine = pixels.bytesPerLine();
+
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+
+	bool written = file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+	written		 = written && file.write(reinterpret_cast<const char*>(pixels.constBits()), pixels.sizeInBytes()) == pixels.sizeInBytes();
+	return written;
+}
+
+/*!
+ * \brief Get the tiles of a prebuilt sheet
+ *
+ * The image uses the given bytes in place, which must outlive it, unless they aren't aligned
+ * on 32 bits.
+ *
+ * \return A null image if the bytes aren't a sheet of this version
+ */
+QImage SpriteSheet::load(const uchar* data, qint64 size)
+{
+	SpriteSheetHeader header;
+	if (!data || size < static_cast<qint64>(sizeof(header)))
+		return {};
+
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION || header.tileWidth == 0)
+		return {};
+
+	QSize tile(header.tileWidth, header.tileHeight);
+	if (tile != tileSize(header.tileWidth) || header.bytesPerLine < header.tileWidth * NB_COLUMNS * 4
+		|| size < static_cast<qint64>(sizeof(header)) + static_cast<qint64>(header.bytesPerLine) * tile.height() * NB_ROWS)
+		return {};
+
+	const uchar* pixels = data + sizeof(header);
+	QSize		 sheetSize(tile.width() * NB_COLUMNS, tile.height() * NB_ROWS);
+	if (reinterpret_cast<quintptr>(pixels) % 4 == 0)
+		return QImage(pixels, sheetSize.width(), sheetSize.height(), static_cast<qsizetype>(header.bytesPerLine), QImage::Format_ARGB32_Premultiplied);
+
+	QImage sheet(sheetSize, QImage::Format_ARGB32_Premultiplied);
+	for (int y = 0; y < sheetSize.height(); y++)
+		std::memcpy(sheet.scanLine(y), pixels + y * static_cast<qsizetype>(header.bytesPerLine), sheetSize.width() * 4);
+	return sheet;
+}
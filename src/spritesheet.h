@@ -0,0 +1,81 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPRITESHEET_H
+#define SPRITESHEET_H
+
+#include <QImage>
+#include <QRect>
+#include <QString>
+
+#include <cstdint>
+
+class QPainter;
+
+/*!
+ * \brief Header of a prebuilt sprite sheet
+ *
+ * The header is followed by the pixels of the sheet, row after row, as QImage's
+ * ARGB32_Premultiplied words in the byte order of the machine that built the sheet, so that the
+ * game uses them in place without any decoding.
+ */
+struct SpriteSheetHeader
+{
+	char		  magic[8];		//!< SpriteSheet::MAGIC
+	std::uint32_t version;		//!< SpriteSheet::VERSION
+	std::uint32_t tileWidth;	//!< Width of a card, in pixels
+	std::uint32_t tileHeight;	//!< Height of a card, in pixels
+	std::uint32_t bytesPerLine; //!< Size of a row of pixels
+};
+
+static_assert(sizeof(SpriteSheetHeader) % 4 == 0, "the pixels must stay aligned on 32 bits");
+
+/*!
+ * \brief The layout of the card sprites, and their rendering from the card images
+ *
+ * The tiles are laid out one suit per row and one value per column, the back following the kings
+ * of the first row. Each tile is the complete look of a card: the paper, the face and the border.
+ * The sheets are built by freecell-atlas at compile time, and loaded by CardAtlas.
+ */
+class SpriteSheet
+{
+public:
+
+	static constexpr char		   MAGIC[8]		 = {'F', 'C', 'S', 'P', 'R', 'I', 'T', 'E'};
+	static constexpr std::uint32_t VERSION		 = 1;
+	static constexpr int		   CARD_WIDTH	 = 130;
+	static constexpr int		   CARD_HEIGHT	 = 182;
+	static constexpr int		   BORDER_RADIUS = 15;
+	static constexpr int		   MARGIN		 = 5;
+	static constexpr int		   NB_COLUMNS	 = 14;
+	static constexpr int		   NB_ROWS		 = 4;
+	static constexpr int		   NB_TILES		 = NB_COLUMNS * NB_ROWS;
+	static constexpr int		   BACK_TILE	 = NB_COLUMNS - 1;
+
+	[[nodiscard]] static int	 faceTile(int value, int suit) noexcept;
+	[[nodiscard]] static bool	 isUsed(int tile) noexcept;
+	[[nodiscard]] static QString imageName(int tile);
+	[[nodiscard]] static QSize	 tileSize(int tileWidth) noexcept;
+	[[nodiscard]] static QRect	 tileRect(QSize tileSize, int tile) noexcept;
+
+	static void renderTile(QPainter& painter, const QRect& target, const QImage& paper, const QImage& face);
+	static bool save(const QImage& sheet, int tileWidth, const QString& path);
+
+	[[nodiscard]] static QImage load(const uchar* data, qint64 size);
+};
+
+#endif // SPRITESHEET_H
@@ -0,0 +1,124 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "supermove.h"
+
+#include "rules.h"
+
+namespace
+{
+	/*!
+	 * \brief Writer of the single-card moves of a supermove
+	 *
+	 * The temporary spots are passed as arrays on the stack: the free cells in `cells`, the
+	 * empty columns in `columns`. Each level of recursion parks part of the run in the last
+	 * empty column, and hands the other ones down.
+	 */
+	struct Expander
+	{
+		StateMove* steps;
+		int		   count = 0;
+
+		void push(int from, int to) noexcept
+		{
+			steps[count++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), 1};
+		}
+
+		void move(int cards, int from, int to, const std::uint8_t* cells, int cellCount, const std::uint8_t* columns, int columnCount) noexcept
+		{
+			if (cards <= cellCount + 1)
+			{
+				for (int i = 0; i < cards - 1; i++)
+				{
+					push(from, cells[i]);
+				}
+				push(from, to);
+				for (int i = cards - 2; i >= 0; i--)
+				{
+					push(cells[i], to);
+				}
+				return;
+			}
+
+			// without the last empty column, the others move half as many cards
+			int capacity = (cellCount + 1) << (columnCount - 1);
+			int parked	 = cards - capacity;
+			int column	 = columns[columnCount - 1];
+			if (parked <= 0)
+			{
+				move(cards, from, to, cells, cellCount, columns, columnCount - 1);
+				return;
+			}
+
+			move(parked, from, column, cells, cellCount, columns, columnCount - 1);
+			move(capacity, from, to, cells, cellCount, columns, columnCount - 1);
+			move(parked, column, to, cells, cellCount, columns, columnCount - 1);
+		}
+	};
+} // namespace
+
+/*!
+ * \brief Expand a move into single-card moves through the free cells and empty columns
+ *
+ * The sequence uses as few empty columns as it can. Runs topped by an ace aren't expanded, since
+ * an ace may not rest in a free cell: autoplay takes it away first anyway.
+ * \param state The position the move is played from
+ * \param move  A legal move
+ * \param steps Receives the single-card moves, at least MAX_SUPERMOVE_STEPS of them
+ * \return The number of single-card moves, 0 if the move is illegal or can't be expanded
+ */
+int expandSupermove(const GameState& state, StateMove move, StateMove* steps) noexcept
+{
+	if (!state.isLegal(move))
+	{
+		return 0;
+	}
+	if (move.count == 1)
+	{
+		steps[0] = move;
+		return 1;
+	}
+
+	int column = move.from - GameState::FIRST_COLUMN;
+	if (!canGoToFreecell(state.columnCard(column, state.columnSize(column) - 1)))
+	{
+		return 0;
+	}
+
+	std::uint8_t cells[GameState::NB_FREECELLS];
+	std::uint8_t columns[GameState::NB_COLUMNS];
+	int			 cellCount	 = 0;
+	int			 columnCount = 0;
+	for (int cell = 0; cell < GameState::NB_FREECELLS; cell++)
+	{
+		if (state.freecell(cell) == NO_CARD)
+		{
+			cells[cellCount++] = static_cast<std::uint8_t>(GameState::FIRST_FREECELL + cell);
+		}
+	}
+	for (int other = 0; other < GameState::NB_COLUMNS; other++)
+	{
+		if (state.columnSize(other) == 0 && GameState::FIRST_COLUMN + other != move.to)
+		{
+			columns[columnCount++] = static_cast<std::uint8_t>(GameState::FIRST_COLUMN + other);
+		}
+	}
+
+	Expander expander{steps};
+	expander.move(move.count, move.from, move.to, cells, cellCount, columns, columnCount);
+	return expander.count;
+}
@@ -0,0 +1,37 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SUPERMOVE_H
+#define SUPERMOVE_H
+
+#include "gamestate.h"
+
+/*!
+ * \file supermove.h
+ * \brief Decomposition of the moves of several cards into moves of single cards
+ *
+ * A GameState move may carry a whole run of cards at once, as long as the free cells and empty
+ * columns would allow moving it one card at a time. expandSupermove() finds that sequence of
+ * single-card moves, as standard solution formats and strict validators expect it.
+ */
+
+//! Maximum number of single-card moves of a supermove: 49 are needed for 13 cards with no free cell and 4 empty columns
+inline constexpr int MAX_SUPERMOVE_STEPS = 64;
+
+int expandSupermove(const GameState& state, StateMove move, StateMove* steps) noexcept;
+
+#endif // SUPERMOVE_H
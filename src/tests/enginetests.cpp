@@ -0,0 +1,360 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*!
+ * \file enginetests.cpp
+ * \brief Checks of the headless game engine, run by ctest
+ *
+ * Usage: freecell-tests <test>
+ *
+ * The tests play random or solved games from fixed seeds, and report every check that fails.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gamestate.h"
+#include "mappedfile.h"
+#include "movejournal.h"
+#include "notation.h"
+#include "solutionfile.h"
+#include "solver.h"
+#include "timeline.h"
+
+namespace
+{
+	int failures = 0;
+
+	/*!
+	 * \brief Report a failed check, and carry on so that a run shows every failure
+	 */
+	void check(bool condition, const char* what, unsigned int gameNumber)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "FAILED: %s (game #%u)\n", what, gameNumber);
+			failures++;
+		}
+	}
+
+	/*!
+	 * \brief Pick a random legal move
+	 * \return The move, invalid if there is none
+	 */
+	StateMove randomMove(const GameState& state, std::mt19937& generator)
+	{
+		StateMove moves[GameState::MAX_MOVES];
+		int		  count = state.legalMoves(moves);
+		if (count == 0)
+		{
+			return {};
+		}
+		return moves[std::uniform_int_distribution<int>(0, count - 1)(generator)];
+	}
+
+	/*!
+	 * \brief Play random moves from a deal
+	 * \param positions Receives the deal, then the position after each move
+	 * \param moves     Receives the moves
+	 */
+	void randomGame(unsigned int gameNumber, int length, std::mt19937& generator, std::vector<GameState>& positions, std::vector<StateMove>& moves)
+	{
+		GameState state = GameState::fromGameNumber(gameNumber);
+		positions.assign(1, state);
+		moves.clear();
+		for (int i = 0; i < length; i++)
+		{
+			StateMove move = randomMove(state, generator);
+			if (!move.isValid())
+			{
+				break;
+			}
+			state.apply(move);
+			positions.push_back(state);
+			moves.push_back(move);
+		}
+	}
+
+	/*!
+	 * \brief Apply and revert random moves, checking the incremental hashes after each of them
+	 */
+	void applyUndo()
+	{
+		std::mt19937		   generator(1);
+		std::vector<GameState> positions;
+		std::vector<StateMove> moves;
+		for (unsigned int gameNumber = 1; gameNumber <= 200; gameNumber++)
+		{
+			randomGame(gameNumber, 200, generator, positions, moves);
+			for (std::size_t i = 0; i < moves.size(); i++)
+			{
+				const GameState& before = positions[i];
+				const GameState& after	= positions[i + 1];
+				check(before.isLegal(moves[i]), "legalMoves() only gives legal moves", gameNumber);
+				check(after.zobristHash() == after.computeHash(false), "the incremental hash matches computeHash(false)", gameNumber);
+				check(after.canonicalHash() == after.computeHash(true), "the incremental canonical hash matches computeHash(true)", gameNumber);
+
+				GameState reverted = after;
+				reverted.unapply(moves[i]);
+				check(reverted == before, "unapply() restores the position and its hashes", gameNumber);
+			}
+
+			GameState state = positions.back();
+			for (std::size_t i = moves.size(); i-- > 0;)
+			{
+				state.unapply(moves[i]);
+			}
+			check(state == positions.front(), "unapplying every move in reverse order gives the deal back", gameNumber);
+		}
+	}
+
+	/*!
+	 * \brief Undo, redo and jump in a journal followed by a timeline, against the positions played
+	 *
+	 * The journal is small enough to forget its oldest moves, so that the keyframes are dropped
+	 * with them.
+	 */
+	void journalTimeline()
+	{
+		std::mt19937		   generator(2);
+		std::vector<GameState> positions;
+		std::vector<StateMove> moves;
+		for (unsigned int gameNumber = 1; gameNumber <= 50; gameNumber++)
+		{
+			randomGame(gameNumber, 300, generator, positions, moves);
+
+			MoveJournal journal(64);
+			Timeline	timeline(8);
+			timeline.reset(positions.front());
+			for (std::size_t i = 0; i < moves.size(); i++)
+			{
+				journal.record(moves[i]);
+				timeline.record(journal, positions[i + 1]);
+			}
+			check(journal.offset() + journal.size() == moves.size(), "the journal counts the moves it forgot", gameNumber);
+			check(journal.position() == journal.size(), "the cursor follows the last move recorded", gameNumber);
+
+			// every position the journal still holds, from the keyframes
+			for (std::size_t position = 0; position <= journal.size(); position++)
+			{
+				check(timeline.stateAt(journal, position) == positions[journal.offset() + position], "stateAt() rebuilds the position", gameNumber);
+			}
+
+			// undo everything, then redo everything
+			GameState state = positions.back();
+			while (journal.canUndo())
+			{
+				state.unapply(journal.undo());
+				check(state == positions[journal.offset() + journal.position()], "undo() walks back the positions played", gameNumber);
+			}
+			check(!journal.undo().isValid(), "undo() stops at the oldest move kept", gameNumber);
+			while (journal.canRedo())
+			{
+				state.apply(journal.redo());
+				check(state == positions[journal.offset() + journal.position()], "redo() walks forward the positions played", gameNumber);
+			}
+			check(state == positions.back(), "redoing every move gives the last position back", gameNumber);
+
+			// jump back, then play another move: the moves after the jump and their keyframes go
+			std::size_t jump = journal.size() / 3;
+			journal.seek(jump);
+			state = timeline.stateAt(journal, jump);
+			check(state == positions[journal.offset() + jump], "seek() and stateAt() jump to the position", gameNumber);
+
+			StateMove move = randomMove(state, generator);
+			if (!move.isValid())
+			{
+				continue;
+			}
+			state.apply(move);
+			journal.record(move);
+			timeline.record(journal, state);
+			check(!journal.canRedo() && journal.size() == jump + 1, "recording after a jump drops the moves that followed", gameNumber);
+			check(timeline.stateAt(journal, journal.size()) == state, "the timeline follows the new branch", gameNumber);
+			check(timeline.stateAt(journal, jump) == positions[journal.offset() + jump], "the timeline keeps the positions before the branch", gameNumber);
+		}
+	}
+
+	/*!
+	 * \brief Solutions of consecutive deals, found by the solver
+	 */
+	struct Solution
+	{
+		std::uint32_t		   gameNumber;
+		std::vector<StateMove> moves;
+	};
+
+	std::vector<Solution> solveDeals(std::uint32_t first, std::uint32_t count)
+	{
+		SolverLimits limits;
+		limits.maxNodes	 = 200'000;
+		limits.maxMemory = 64 << 20;
+
+		Solver				  solver(limits);
+		std::vector<Solution> solutions;
+		for (std::uint32_t gameNumber = first; gameNumber < first + count; gameNumber++)
+		{
+			if (solver.solve(GameState::fromGameNumber(gameNumber)) == Solver::Result::Solved)
+			{
+				solutions.push_back({gameNumber, solver.solution()});
+			}
+		}
+		return solutions;
+	}
+
+	/*!
+	 * \brief Write and read back the notation of every legal move of random positions, then of solutions
+	 */
+	void notation()
+	{
+		std::mt19937		   generator(3);
+		std::vector<GameState> positions;
+		std::vector<StateMove> moves;
+		for (unsigned int gameNumber = 1; gameNumber <= 100; gameNumber++)
+		{
+			randomGame(gameNumber, 100, generator, positions, moves);
+			for (const auto& state : positions)
+			{
+				StateMove legalMoves[GameState::MAX_MOVES];
+				int		  count = state.legalMoves(legalMoves);
+				for (int i = 0; i < count; i++)
+				{
+					char	  text[MAX_NOTATION_LENGTH];
+					int		  length = formatMove(state, legalMoves[i], text);
+					StateMove parsed;
+					check(parseMove(state, text, text + length, parsed) == text + length && parsed == legalMoves[i], "parseMove() reads formatMove()",
+						  gameNumber);
+				}
+			}
+		}
+
+		std::string text;
+		auto		solutions = solveDeals(1, 50);
+		for (const auto& solution : solutions)
+		{
+			formatSolution(solution.gameNumber, solution.moves.data(), solution.moves.size(), text);
+		}
+
+		const char* position = text.data();
+		const char* end		 = position + text.size();
+		for (const auto& solution : solutions)
+		{
+			std::uint32_t		   gameNumber = 0;
+			std::vector<StateMove> parsed;
+			position = parseSolution(position, end, gameNumber, parsed);
+			check(position && gameNumber == solution.gameNumber && parsed == solution.moves, "parseSolution() reads formatSolution()",
+				  solution.gameNumber);
+			if (!position)
+			{
+				return;
+			}
+		}
+		check(position == end, "parseSolution() reads every line", 0);
+	}
+
+	/*!
+	 * \brief Write solutions to a file, then iterate and look them up
+	 */
+	void solutionFile()
+	{
+		auto solutions = solveDeals(1, 300);
+		auto path	   = std::filesystem::temp_directory_path() / "freecell-tests.fcs";
+
+		SolutionWriter writer(256); // small buffer, flushed many times
+		check(writer.open(path.string().c_str()), "the writer creates the file", 0);
+		for (const auto& solution : solutions)
+		{
+			check(writer.add(solution.gameNumber, solution.moves.data(), solution.moves.size()), "the writer adds a solution", solution.gameNumber);
+		}
+		check(!writer.add(1, solutions.front().moves.data(), solutions.front().moves.size()), "the writer rejects a game out of order", 1);
+		check(writer.close(), "the writer completes the file", 0);
+
+		MappedFile mapping(path.string().c_str());
+		SolutionFile file(mapping.data(), mapping.size());
+		check(file.isValid() && file.count() == solutions.size(), "the file holds every solution", 0);
+
+		auto expected = solutions.begin();
+		for (const auto& record : file)
+		{
+			if (expected == solutions.end())
+			{
+				check(false, "the file has no extra records", record.gameNumber);
+				break;
+			}
+			std::vector<StateMove> read(record.moveCount);
+			for (int i = 0; i < record.moveCount; i++)
+			{
+				read[i] = record.move(i);
+			}
+			check(record.gameNumber == expected->gameNumber && read == expected->moves, "records are read back in order", expected->gameNumber);
+			++expected;
+		}
+
+		for (const auto& solution : solutions)
+		{
+			SolutionRecord record;
+			check(file.find(solution.gameNumber, record) && record.gameNumber == solution.gameNumber && record.moveCount == solution.moves.size(),
+				  "find() reaches the record of a game", solution.gameNumber);
+		}
+		SolutionRecord record;
+		check(!file.find(solutions.back().gameNumber + 1, record), "find() fails for a game without a solution", solutions.back().gameNumber + 1);
+
+		mapping.close();
+		std::filesystem::remove(path);
+	}
+
+	struct Test
+	{
+		const char* name;
+		void (*run)();
+	};
+
+	const Test TESTS[] = {
+		{"apply-undo", applyUndo},
+		{"journal-timeline", journalTimeline},
+		{"notation", notation},
+		{"solution-file", solutionFile},
+	};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 2)
+	{
+		for (const auto& test : TESTS)
+		{
+			if (std::strcmp(argv[1], test.name) == 0)
+			{
+				test.run();
+				std::printf("%s: %d failure(s)\n", test.name, failures);
+				return failures == 0 ? 0 : 1;
+			}
+		}
+	}
+
+	std::printf("Usage: %s <test>\n\nTests:\n", argv[0]);
+	for (const auto& test : TESTS)
+	{
+		std::printf("  %s\n", test.name);
+	}
+	return 1;
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timeline.h"
+
+#include <algorithm>
+
+/*!
+ * \brief Constructor
+ * \param interval The number of moves between two keyframes
+ */
+Timeline::Timeline(std::size_t interval)
+	: m_interval(interval ? interval : 1)
+{
+}
+
+/*!
+ * \brief Forget every keyframe, and start again from a new game
+ * \param start The position before the first move
+ */
+void Timeline::reset(const GameState& start)
+{
+	m_keyframes.clear();
+	m_keyframes.push_back({0, start});
+}
+
+/*!
+ * \brief Follow a move just recorded in the journal
+ * \param journal The journal, its cursor right after the new move
+ * \param state   The position the move leads to
+ */
+void Timeline::record(const MoveJournal& journal, const GameState& state)
+{
+	std::uint64_t move = journal.offset() + journal.position();
+
+	// the keyframes from the move on followed the moves the journal just dropped
+	while (!m_keyframes.empty() && m_keyframes.back().move >= move)
+	{
+		m_keyframes.pop_back();
+	}
+	if (m_keyframes.empty() || move - m_keyframes.back().move >= m_interval)
+	{
+		m_keyframes.push_back({move, state});
+	}
+
+	// and the ones before the oldest move of the journal can't be played from anymore
+	auto usable = std::find_if(m_keyframes.begin(), m_keyframes.end() - 1, [&](const Keyframe& keyframe) { return keyframe.move >= journal.offset(); });
+	m_keyframes.erase(m_keyframes.begin(), usable);
+}
+
+/*!
+ * \brief Rebuild a position of the journal
+ * \param journal  The journal the timeline follows
+ * \param position The number of moves of the journal played, from 0 to journal.size()
+ * \return The position, rebuilt from the nearest keyframe
+ */
+GameState Timeline::stateAt(const MoveJournal& journal, std::size_t position) const noexcept
+{
+	std::uint64_t target = journal.offset() + std::min(position, journal.size());
+
+	// the first keyframe after the target, and the one before it
+	auto next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), target, [](std::uint64_t move, const Keyframe& keyframe) { return move < keyframe.move; });
+	auto nearest = next;
+	if (next == m_keyframes.end() || (next != m_keyframes.begin() && target - (next - 1)->move <= next->move - target))
+	{
+		nearest = next - 1;
+	}
+
+	GameState	  state = nearest->state;
+	std::uint64_t move	= nearest->move;
+	for (; move < target; move++)
+	{
+		state.apply(journal.at(static_cast<std::size_t>(move - journal.offset())));
+	}
+	for (; move > target; move--)
+	{
+		state.unapply(journal.at(static_cast<std::size_t>(move - 1 - journal.offset())));
+	}
+	return state;
+}
+
+std::size_t Timeline::interval() const noexcept
+{
+	return m_interval;
+}
+
+std::size_t Timeline::keyframeCount() const noexcept
+{
+	return m_keyframes.size();
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gamestate.h"
+#include "movejournal.h"
+
+/*!
+ * \brief Snapshots of a game taken every few moves, to jump anywhere in its move journal
+ *
+ * The timeline keeps a keyframe, the position reached after some move, every interval() moves
+ * of the journal. Any position of the journal is then rebuilt from the nearest keyframe, playing
+ * or reverting at most interval() moves. Keyframes are dropped along with the moves they follow:
+ * when a move is recorded after some undos, or when the journal forgets its oldest moves.
+ *
+ * The timeline doesn't own the journal: every move recorded in the journal must be reported to
+ * record() with the position it leads to, and the journal must hold more than interval() moves.
+ */
+class Timeline
+{
+public:
+
+	static constexpr std::size_t DEFAULT_INTERVAL = 32;
+
+public:
+
+	explicit Timeline(std::size_t interval = DEFAULT_INTERVAL);
+
+	void reset(const GameState& start);
+	void record(const MoveJournal& journal, const GameState& state);
+
+	[[nodiscard]] GameState	  stateAt(const MoveJournal& journal, std::size_t position) const noexcept;
+	[[nodiscard]] std::size_t interval() const noexcept;
+	[[nodiscard]] std::size_t keyframeCount() const noexcept;
+
+protected:
+
+	struct Keyframe
+	{
+		std::uint64_t move; //!< Number of moves played since the start of the game
+		GameState	  state;
+	};
+
+	std::size_t			  m_interval;
+	std::vector<Keyframe> m_keyframes;
+};
+
+#endif // TIMELINE_H
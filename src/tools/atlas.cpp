@@ -0,0 +1,108 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file atlas.cpp
+ * \brief Build-time rendering of the card sprite sheets
+ *
+ * Usage: freecell-atlas <resources directory> <output directory> <scale>...
+ *
+ * Every card image of the resources is rendered once per scale, at the size of the cards times
+ * the scale, into `cards@<scale>x.sprites`. The game bundles the sheets uncompressed and uses
+ * their pixels in place, so it never decodes nor scales the card images at startup.
+ */
+
+#include <QDir>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "spritesheet.h"
+
+int main(int argc, char* argv[])
+{
+	if (argc < 4)
+	{
+		std::fprintf(stderr, "Usage: %s <resources directory> <output directory> <scale>...\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// the images are rendered offscreen, the build machine may have no display
+	qputenv("QT_QPA_PLATFORM", "offscreen");
+	QGuiApplication app(argc, argv);
+
+	QDir resources(QString::fromLocal8Bit(argv[1]));
+	QDir output(QString::fromLocal8Bit(argv[2]));
+
+	auto start = std::chrono::steady_clock::now();
+
+	QImage paper(resources.filePath("images/playing_card.jpg"));
+	if (paper.isNull())
+		std::fprintf(stderr, "Can't read the card paper, the cards are plain white\n");
+
+	QImage faces[SpriteSheet::NB_TILES];
+	for (int tile = 0; tile < SpriteSheet::NB_TILES; tile++)
+	{
+		if (!SpriteSheet::isUsed(tile))
+			continue;
+
+		QString path = resources.filePath("cards/" + SpriteSheet::imageName(tile));
+		if (!faces[tile].load(path))
+		{
+			std::fprintf(stderr, "Can't read %s\n", qPrintable(path));
+			return EXIT_FAILURE;
+		}
+	}
+
+	for (int i = 3; i < argc; i++)
+	{
+		int scale = std::atoi(argv[i]);
+		if (scale < 1)
+		{
+			std::fprintf(stderr, "Invalid scale %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+
+		QSize  tileSize = SpriteSheet::tileSize(SpriteSheet::CARD_WIDTH * scale);
+		QImage sheet(tileSize.width() * SpriteSheet::NB_COLUMNS, tileSize.height() * SpriteSheet::NB_ROWS, QImage::Format_ARGB32_Premultiplied);
+		sheet.fill(Qt::transparent);
+
+		QPainter painter(&sheet);
+		for (int tile = 0; tile < SpriteSheet::NB_TILES; tile++)
+		{
+			if (SpriteSheet::isUsed(tile))
+				SpriteSheet::renderTile(painter, SpriteSheet::tileRect(tileSize, tile), paper, faces[tile]);
+		}
+		painter.end();
+
+		QString path = output.filePath(QString("cards@%1x.sprites").arg(scale));
+		if (!SpriteSheet::save(sheet, tileSize.width(), path))
+		{
+			std::fprintf(stderr, "Can't write %s\n", qPrintable(path));
+			return EXIT_FAILURE;
+		}
+		std::printf("%s: %dx%d cards, %lld bytes\n", qPrintable(path), tileSize.width(), tileSize.height(), static_cast<long long>(sheet.sizeInBytes()));
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::printf("Rendered in %.2f s\n", elapsed.count());
+	return EXIT_SUCCESS;
+}
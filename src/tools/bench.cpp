@@ -0,0 +1,505 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file bench.cpp
+ * \brief Headless benchmarks of the game engine
+ *
+ * Usage: freecell-bench <benchmark> [options]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "dealgenerator.h"
+#include "gamestate.h"
+#include "options.h"
+#include "parallelsolver.h"
+#include "solver.h"
+#include "supermove.h"
+
+namespace
+{
+	/*!
+	 * \brief Solve a fixed corpus of consecutive game numbers with 1 to N threads
+	 *
+	 * Options: --deals (100), --first game number (1000000), --threads maximum (all cores),
+	 * --nodes node budget per deal (200000)
+	 */
+	int solverScaling(int argc, char* argv[])
+	{
+		Options		 options(argc, argv);
+		long		 deals		= options.get("--deals", 100);
+		long		 first		= options.get("--first", 1'000'000);
+		unsigned int maxThreads = options.get("--threads", std::max(1u, std::thread::hardware_concurrency()));
+
+		SolverLimits limits;
+		limits.maxNodes	 = options.get("--nodes", 200'000);
+		limits.maxMemory = 256 << 20;
+		if (!options.isValid())
+		{
+			return Options::USAGE;
+		}
+
+		std::vector<GameState> corpus;
+		for (long i = 0; i < deals; i++)
+		{
+			corpus.push_back(GameState::fromGameNumber(static_cast<unsigned int>(first + i)));
+		}
+
+		std::printf("%ld deals from game #%ld, %zu nodes per deal\n\n", deals, first, limits.maxNodes);
+		std::printf("%-10s %8s %10s %12s %10s %8s %10s\n", "solver", "solved", "time (s)", "states/s", "deals/s", "speedup", "efficiency");
+
+		auto report = [&](const char* name, unsigned int threads, int solved, double seconds, std::uint64_t nodes, double baseline)
+		{
+			double speedup = baseline > 0.0 ? baseline / seconds : 1.0;
+			std::printf("%-10s %8d %10.3f %12.0f %10.1f %8.2f %9.0f%%\n", name, solved, seconds, nodes / seconds, deals / seconds, speedup,
+						100.0 * speedup / threads);
+		};
+
+		// reference: the serial solver
+		{
+			Solver		  solver(limits);
+			int			  solved = 0;
+			std::uint64_t nodes	 = 0;
+			auto		  start	 = std::chrono::steady_clock::now();
+			for (const auto& deal : corpus)
+			{
+				solved += solver.solve(deal) == Solver::Result::Solved;
+				nodes += solver.stats().nodesExpanded;
+			}
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			report("serial", 1, solved, seconds, nodes, 0.0);
+		}
+
+		// 1, 2, 4... threads, and the maximum
+		std::vector<unsigned int> threadCounts;
+		for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+		{
+			threadCounts.push_back(threads);
+		}
+		threadCounts.push_back(maxThreads);
+
+		double baseline = 0.0;
+		for (unsigned int threads : threadCounts)
+		{
+			ParallelSolver solver(threads, limits);
+			int			   solved = 0;
+			std::uint64_t  nodes  = 0;
+			auto		   start  = std::chrono::steady_clock::now();
+			for (const auto& deal : corpus)
+			{
+				solved += solver.solve(deal) == Solver::Result::Solved;
+				nodes += solver.stats().nodesExpanded;
+			}
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (threads == 1)
+			{
+				baseline = seconds;
+			}
+
+			std::string name = std::to_string(threads) + " thr";
+			report(name.c_str(), threads, solved, seconds, nodes, baseline);
+		}
+		return 0;
+	}
+
+	/*!
+	 * \brief Generate consecutive deals into a flat buffer
+	 *
+	 * Options: --deals (10000000), --first game number (1)
+	 */
+	int dealGenerator(int argc, char* argv[])
+	{
+		Options options(argc, argv);
+		long	deals = options.get("--deals", 10'000'000);
+		long	first = options.get("--first", 1);
+		if (!options.isValid())
+		{
+			return Options::USAGE;
+		}
+
+		// generate by batches, as an analytics job would
+		constexpr long		BATCH = 65536;
+		std::vector<CardId> buffer(BATCH * NB_CARDS);
+		unsigned int		checksum = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		for (long done = 0; done < deals; done += BATCH)
+		{
+			long count = std::min(BATCH, deals - done);
+			DealGenerator::fill(static_cast<std::uint32_t>(first + done), count, buffer.data());
+			checksum += buffer[(count - 1) * NB_CARDS];
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::printf("%ld deals from game #%ld in %.3f s: %.1f M deals/s (checksum %u)\n", deals, first, seconds, deals / seconds / 1e6, checksum);
+		return 0;
+	}
+
+	/*!
+	 * \brief Movability of the stack starting at a card, the way Card::isMovable used to tell it
+	 *
+	 * Every card of the stack is checked against the next one, and the free cells and empty
+	 * columns are counted again for each of them.
+	 */
+	bool isMovableByScan(const GameState& state, int column, int index)
+	{
+		int size = state.columnSize(column);
+		if (index == size - 1)
+		{
+			return true;
+		}
+
+		CardId card	 = state.columnCard(column, index);
+		CardId child = state.columnCard(column, index + 1);
+		if (cardValue(card) - cardValue(child) != 1 || cardIsRed(card) == cardIsRed(child) || !isMovableByScan(state, column, index + 1))
+		{
+			return false;
+		}
+
+		int freeCells	 = 0;
+		int emptyColumns = 0;
+		for (int i = 0; i < GameState::NB_FREECELLS; i++)
+		{
+			freeCells += state.freecell(i) == NO_CARD;
+		}
+		for (int i = 0; i < GameState::NB_COLUMNS; i++)
+		{
+			emptyColumns += state.columnSize(i) == 0;
+		}
+		return size - index <= (freeCells + 1) * (int)std::pow(2, emptyColumns);
+	}
+
+	/*!
+	 * \brief Movability of the stack starting at a card, from the metrics kept by GameState
+	 */
+	bool isMovableByMetrics(const GameState& state, int column, int index)
+	{
+		int count = state.columnSize(column) - index;
+		return count <= state.runLength(column) && count <= (state.countFreeCells() + 1) << state.countEmptyColumns();
+	}
+
+	/*!
+	 * \brief Evaluate which cards can be picked up, as a click does, on positions of real games
+	 *
+	 * Options: --positions (2000), --rounds (200)
+	 */
+	int metrics(int argc, char* argv[])
+	{
+		Options options(argc, argv);
+		long	positions = options.get("--positions", 2000);
+		long	rounds	  = options.get("--rounds", 200);
+		if (!options.isValid())
+		{
+			return Options::USAGE;
+		}
+
+		// positions met while playing random moves from actual deals
+		std::vector<GameState> corpus;
+		std::mt19937		   generator(1);
+		StateMove			   legalMoves[GameState::MAX_MOVES];
+		for (long i = 0; corpus.size() < static_cast<std::size_t>(positions); i++)
+		{
+			GameState state = GameState::fromGameNumber(static_cast<unsigned int>(1'000'000 + i));
+			for (int move = 0; move < 60; move++)
+			{
+				int count = state.legalMoves(legalMoves);
+				if (count == 0)
+				{
+					break;
+				}
+				state.apply(legalMoves[generator() % count]);
+				if (move % 10 == 9)
+				{
+					corpus.push_back(state);
+				}
+			}
+		}
+
+		auto run = [&](const char* name, auto isMovable)
+		{
+			long movable = 0;
+			long checks	 = 0;
+			auto start	 = std::chrono::steady_clock::now();
+			for (long round = 0; round < rounds; round++)
+			{
+				for (const auto& state : corpus)
+				{
+					for (int column = 0; column < GameState::NB_COLUMNS; column++)
+					{
+						for (int index = 0; index < state.columnSize(column); index++)
+						{
+							movable += isMovable(state, column, index);
+							checks++;
+						}
+					}
+				}
+			}
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::printf("%-8s %12ld %10ld %10.2f\n", name, checks, movable, seconds * 1e9 / checks);
+			return seconds;
+		};
+
+		std::printf("%zu positions, %ld rounds\n\n", corpus.size(), rounds);
+		std::printf("%-8s %12s %10s %10s\n", "rules", "checks", "movable", "ns/check");
+		double scan		  = run("scan", isMovableByScan);
+		double metrics	  = run("metrics", isMovableByMetrics);
+		std::printf("\nspeedup %.1fx\n", scan / metrics);
+		return 0;
+	}
+
+	/*!
+	 * \brief Full description of a position, as a key to tell distinct positions apart
+	 * \param canonical Whether to sort the columns and the freecells, as canonicalHash() ignores their order
+	 */
+	std::string describe(const GameState& state, bool canonical)
+	{
+		std::vector<std::string> columns;
+		for (int column = 0; column < GameState::NB_COLUMNS; column++)
+		{
+			std::string cards;
+			for (int i = 0; i < state.columnSize(column); i++)
+			{
+				cards += static_cast<char>(state.columnCard(column, i));
+			}
+			columns.push_back(cards);
+		}
+		std::string freecells;
+		for (int cell = 0; cell < GameState::NB_FREECELLS; cell++)
+		{
+			freecells += static_cast<char>(state.freecell(cell));
+		}
+		if (canonical)
+		{
+			std::sort(columns.begin(), columns.end());
+			std::sort(freecells.begin(), freecells.end());
+		}
+
+		std::string description = freecells;
+		for (int foundation = 0; foundation < GameState::NB_FOUNDATIONS; foundation++)
+		{
+			description += static_cast<char>(state.foundation(foundation));
+		}
+		for (const auto& column : columns)
+		{
+			description += '|' + column;
+		}
+		return description;
+	}
+
+	/*!
+	 * \brief Count the Zobrist hash collisions over positions of real games, and time the updates
+	 *
+	 * Options: --positions (1000000)
+	 */
+	int zobrist(int argc, char* argv[])
+	{
+		Options options(argc, argv);
+		long	positions = options.get("--positions", 1'000'000);
+		if (!options.isValid())
+		{
+			return Options::USAGE;
+		}
+
+		// random walks from actual deals, so that positions share long common histories
+		std::vector<GameState> corpus;
+		std::vector<GameState> deals;
+		std::vector<StateMove> walks; // the moves of each walk, one after the other
+		std::vector<int>	   walkLengths;
+		corpus.reserve(positions);
+		walks.reserve(positions);
+		std::mt19937 generator(1);
+		StateMove	 legalMoves[GameState::MAX_MOVES];
+		for (long i = 0; static_cast<long>(corpus.size()) < positions; i++)
+		{
+			GameState state = GameState::fromGameNumber(static_cast<unsigned int>(1'000'000 + i));
+			deals.push_back(state);
+			walkLengths.push_back(0);
+			for (int move = 0; move < 200 && static_cast<long>(corpus.size()) < positions; move++)
+			{
+				int count = state.legalMoves(legalMoves);
+				if (count == 0)
+				{
+					break;
+				}
+				walks.push_back(legalMoves[generator() % count]);
+				walkLengths.back()++;
+				state.apply(walks.back());
+				corpus.push_back(state);
+			}
+		}
+
+		std::printf("%zu positions\n\n", corpus.size());
+		std::printf("%-10s %10s %12s %12s\n", "hash", "distinct", "collisions", "expected");
+		for (bool canonical : {false, true})
+		{
+			std::unordered_map<std::uint64_t, std::string> seen;
+			long										   collisions = 0;
+			for (const auto& state : corpus)
+			{
+				std::uint64_t hash		  = canonical ? state.canonicalHash() : state.zobristHash();
+				std::string	  description = describe(state, canonical);
+				auto [it, inserted]		  = seen.emplace(hash, description);
+				if (!inserted && it->second != description)
+				{
+					collisions++;
+				}
+			}
+			// birthday bound for 64-bit keys
+			double n = static_cast<double>(seen.size());
+			std::printf("%-10s %10zu %12ld %12.2g\n", canonical ? "canonical" : "exact", seen.size(), collisions, n * n / 2.0 / 18446744073709551616.0);
+		}
+
+		// replaying the walks: apply updates the hashes along with the move, against apply followed
+		// by hashing the position from scratch
+		std::uint64_t checksum = 0;
+
+		auto replay = [&](bool fromScratch)
+		{
+			auto			 start = std::chrono::steady_clock::now();
+			const StateMove* move  = walks.data();
+			for (std::size_t walk = 0; walk < deals.size(); walk++)
+			{
+				GameState state = deals[walk];
+				for (int i = 0; i < walkLengths[walk]; i++)
+				{
+					state.apply(*move++);
+					checksum += fromScratch ? state.computeHash(true) : state.canonicalHash();
+				}
+			}
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		};
+		double incremental = replay(false);
+		double scratch	   = replay(true);
+
+		std::printf("\napply with the incremental hash %.2f ns, apply and hash from scratch %.2f ns per move (checksum %llx)\n",
+					incremental * 1e9 / walks.size(), scratch * 1e9 / walks.size(), static_cast<unsigned long long>(checksum));
+		return 0;
+	}
+
+	/*!
+	 * \brief Expand the solutions of the solver into single-card moves, replaying them to validate them
+	 *
+	 * Options: --deals (200), --rounds (100)
+	 */
+	int supermove(int argc, char* argv[])
+	{
+		Options options(argc, argv);
+		long	deals  = options.get("--deals", 200);
+		long	rounds = options.get("--rounds", 100);
+		if (!options.isValid())
+		{
+			return Options::USAGE;
+		}
+
+		// positions and moves of actual solutions
+		std::vector<std::pair<GameState, StateMove>> corpus;
+		Solver										 solver;
+		for (long i = 0; i < deals; i++)
+		{
+			GameState state = GameState::fromGameNumber(static_cast<unsigned int>(1'000'000 + i));
+			if (solver.solve(state) == Solver::Result::Solved)
+			{
+				for (auto move : solver.solution())
+				{
+					corpus.emplace_back(state, move);
+					state.apply(move);
+				}
+			}
+		}
+
+		long	  supermoves = 0;
+		long	  steps		 = 0;
+		long	  invalid	 = 0;
+		StateMove buffer[MAX_SUPERMOVE_STEPS];
+		auto	  start = std::chrono::steady_clock::now();
+		for (long round = 0; round < rounds; round++)
+		{
+			for (const auto& [state, move] : corpus)
+			{
+				int		  count	 = expandSupermove(state, move, buffer);
+				GameState replay = state;
+				for (int i = 0; i < count; i++)
+				{
+					invalid += !replay.isLegal(buffer[i]);
+					replay.apply(buffer[i]);
+				}
+				GameState expected = state;
+				expected.apply(move);
+				invalid += count == 0 || !(replay == expected);
+				supermoves += move.count > 1;
+				steps += count;
+			}
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::printf("%zu moves, %ld supermoves per round, %ld rounds\n", corpus.size(), supermoves / rounds, rounds);
+		std::printf("%.1f single-card moves per move, %ld invalid\n", static_cast<double>(steps) / (corpus.size() * rounds), invalid);
+		std::printf("%.0f moves expanded and replayed per second\n", corpus.size() * rounds / seconds);
+		return invalid ? 1 : 0;
+	}
+
+	struct Benchmark
+	{
+		const char* name;
+		int (*run)(int argc, char* argv[]);
+		const char* description;
+	};
+
+	const Benchmark BENCHMARKS[] = {
+		{"solver-scaling", solverScaling, "Solve a fixed corpus of deals with the parallel solver on 1 to N threads"},
+		{"deal-generator", dealGenerator, "Generate deals into a flat buffer"},
+		{"zobrist", zobrist, "Count the Zobrist hash collisions over a large sample of positions"},
+		{"metrics", metrics, "Evaluate the movability of every card with scans, then with the incremental metrics"},
+		{"supermove", supermove, "Expand and replay the moves of solver solutions as single-card moves"},
+	};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 2)
+	{
+		for (const auto& benchmark : BENCHMARKS)
+		{
+			if (std::strcmp(argv[1], benchmark.name) == 0)
+			{
+				int status = benchmark.run(argc, argv);
+				if (status != Options::USAGE)
+				{
+					return status;
+				}
+			}
+		}
+	}
+
+	std::printf("Usage: %s <benchmark> [options]\n\nBenchmarks:\n", argv[0]);
+	for (const auto& benchmark : BENCHMARKS)
+	{
+		std::printf("  %-16s %s\n", benchmark.name, benchmark.description);
+	}
+	return 1;
+}
@@ -0,0 +1,273 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file dealscan.cpp
+ * \brief Headless solvability scan of a range of game numbers
+ *
+ * Usage: freecell-dealscan <index file> [options]
+ *
+ * Every deal of the range goes through the solver, and its solvability and difficulty are
+ * written to a deal index file (see `DealIndex`). Deals are scanned by chunks spread over all
+ * the cores, and each chunk is written to the file as soon as it is complete: an interrupted
+ * scan resumes where it stopped when run again on the same file.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dealindex.h"
+#include "gamestate.h"
+#include "options.h"
+#include "solver.h"
+
+namespace
+{
+	// Number of deals scanned and written at once. Even, so that chunks start on a byte.
+	constexpr std::uint32_t CHUNK_SIZE = 4096;
+
+	/*!
+	 * \brief Open an existing index file, or create an empty one
+	 * \param entries Receives the entries already in the file
+	 * \return false if the file can't be used
+	 */
+	bool openIndex(const char* path, DealIndexHeader& header, std::vector<std::uint8_t>& entries, std::fstream& file)
+	{
+		file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+		if (file)
+		{
+			DealIndexHeader existing{};
+			file.read(reinterpret_cast<char*>(&existing), sizeof(existing));
+			if (!file || std::memcmp(existing.magic, DealIndex::MAGIC, sizeof(DealIndex::MAGIC)) != 0 || existing.version != DealIndex::VERSION)
+			{
+				std::fprintf(stderr, "%s is not a deal index\n", path);
+				return false;
+			}
+			if (existing.generatorVersion != GameState::DEAL_GENERATOR_VERSION)
+			{
+				std::fprintf(stderr, "%s was scanned with another deal generator, delete it to start over\n", path);
+				return false;
+			}
+
+			// the count is only trusted once the file is known to hold that many entries
+			file.seekg(0, std::ios::end);
+			if (!file || static_cast<std::size_t>(file.tellg()) != DealIndex::fileSize(existing.count))
+			{
+				std::fprintf(stderr, "%s is truncated or corrupt\n", path);
+				return false;
+			}
+			entries.resize(DealIndex::fileSize(existing.count) - sizeof(DealIndexHeader));
+			file.seekg(sizeof(DealIndexHeader));
+			file.read(reinterpret_cast<char*>(entries.data()), static_cast<std::streamsize>(entries.size()));
+			if (!file)
+			{
+				std::fprintf(stderr, "Can't read %s\n", path);
+				return false;
+			}
+			header = existing;
+			std::printf("Resuming %s\n", path);
+			return true;
+		}
+
+		file.clear();
+		file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		entries.assign(DealIndex::fileSize(header.count) - sizeof(DealIndexHeader), 0);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size()));
+		file.flush();
+		if (!file)
+		{
+			std::fprintf(stderr, "Can't create %s\n", path);
+			return false;
+		}
+		return true;
+	}
+
+	/*!
+	 * \brief Check if a chunk still has deals to scan
+	 */
+	bool isPending(const std::vector<std::uint8_t>& entries, std::uint32_t chunk, std::uint32_t count)
+	{
+		std::uint32_t first = chunk * CHUNK_SIZE;
+		std::uint32_t last	= std::min(first + CHUNK_SIZE, count);
+		for (std::uint32_t i = first; i < last; i++)
+		{
+			if (((entries[i / 2] >> (4 * (i % 2))) & 0xF) == DealIndex::NOT_SCANNED)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*!
+	 * \brief Get the entry of a deal from the outcome of its search
+	 */
+	std::uint8_t entryOf(Solver::Result result, const SolverStats& stats)
+	{
+		switch (result)
+		{
+			case Solver::Result::Solved:
+				return DealIndex::solvedEntry(stats.nodesExpanded);
+			case Solver::Result::Unsolvable:
+				return DealIndex::UNSOLVABLE;
+			default:
+				return DealIndex::UNDECIDED;
+		}
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	Options		 options(argc, argv);
+	unsigned int threads = options.get("--threads", std::max(1u, std::thread::hardware_concurrency()));
+	long		 first	 = options.get("--first", 1'000'000);
+	long		 count	 = options.get("--count", 9'000'000);
+	long		 nodes	 = options.get("--nodes", 200'000);
+	long		 memory	 = options.get("--memory", 256);
+
+	// the last game number must fit too
+	bool validRange = first - 1 <= long(UINT32_MAX) - count;
+
+	if (argc < 2 || argv[1][0] == '-' || !options.isValid() || !validRange)
+	{
+		std::printf("Usage: %s <index file> [options]\n\n"
+					"Options:\n"
+					"  --first <n>    first game number (1000000)\n"
+					"  --count <n>    number of games (9000000)\n"
+					"  --threads <n>  number of threads (all cores)\n"
+					"  --nodes <n>    node budget of the solver per deal (200000)\n"
+					"  --memory <n>   memory budget of the solver per thread, in MiB (256)\n\n"
+					"The range and the node budget of an existing index file are kept when resuming.\n",
+					argv[0]);
+		return 1;
+	}
+
+	const char*		path   = argv[1];
+	DealIndexHeader header = DealIndex::makeHeader(first, count, nodes);
+
+	std::fstream			  file;
+	std::vector<std::uint8_t> entries;
+	if (!openIndex(path, header, entries, file))
+	{
+		return 1;
+	}
+
+	SolverLimits limits;
+	limits.maxNodes	 = header.nodeLimit;
+	limits.maxMemory = std::size_t(memory) << 20;
+
+	std::vector<std::uint32_t> pending;
+	std::uint32_t			   chunks = (header.count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	for (std::uint32_t chunk = 0; chunk < chunks; chunk++)
+	{
+		if (isPending(entries, chunk, header.count))
+		{
+			pending.push_back(chunk);
+		}
+	}
+
+	std::printf("Games #%u to #%u, %zu of %u chunks to scan on %u threads, %u nodes per deal\n", header.firstGame,
+				header.firstGame + header.count - 1, pending.size(), chunks, threads, header.nodeLimit);
+	std::fflush(stdout);
+
+	std::atomic<std::size_t> next = 0;
+	std::size_t				 done = 0;
+	std::mutex				 fileMutex;
+	bool					 writeFailed = false;
+	auto					 start		 = std::chrono::steady_clock::now();
+
+	auto scan = [&]()
+	{
+		Solver					  solver(limits);
+		std::vector<std::uint8_t> bytes(CHUNK_SIZE / 2);
+		for (std::size_t job = next++; job < pending.size(); job = next++)
+		{
+			std::uint32_t first = pending[job] * CHUNK_SIZE;
+			std::uint32_t last	= std::min(first + CHUNK_SIZE, header.count);
+
+			std::fill(bytes.begin(), bytes.end(), 0);
+			for (std::uint32_t i = first; i < last; i++)
+			{
+				Solver::Result result = solver.solve(GameState::fromGameNumber(header.firstGame + i));
+				bytes[(i - first) / 2] |= entryOf(result, solver.stats()) << (4 * (i % 2));
+			}
+
+			std::lock_guard lock(fileMutex);
+			std::size_t		size = (last - first + 1) / 2;
+			file.seekp(static_cast<std::streamoff>(sizeof(DealIndexHeader) + first / 2));
+			file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(size));
+			file.flush();
+			writeFailed = writeFailed || !file;
+			std::copy_n(bytes.begin(), size, entries.begin() + first / 2);
+
+			done++;
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			double rate	   = done * CHUNK_SIZE / seconds;
+			std::fprintf(stderr, "\r%zu/%zu chunks, %.0f deals/s, %.0f min left   ", done, pending.size(), rate,
+						 (pending.size() - done) * CHUNK_SIZE / rate / 60.0);
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		workers.emplace_back(scan);
+	}
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+	std::fprintf(stderr, "\n");
+
+	if (writeFailed)
+	{
+		std::fprintf(stderr, "Can't write %s\n", path);
+		return 1;
+	}
+
+	// summary of the whole index
+	std::array<std::uint32_t, 16> histogram{};
+	for (std::uint32_t i = 0; i < header.count; i++)
+	{
+		histogram[(entries[i / 2] >> (4 * (i % 2))) & 0xF]++;
+	}
+
+	std::uint32_t solvable = 0;
+	for (int difficulty = DealIndex::MIN_DIFFICULTY; difficulty <= DealIndex::MAX_DIFFICULTY; difficulty++)
+	{
+		solvable += histogram[DealIndex::SOLVABLE | difficulty];
+	}
+
+	std::printf("Solvable   %10u\n", solvable);
+	for (int difficulty = DealIndex::MIN_DIFFICULTY; difficulty <= DealIndex::MAX_DIFFICULTY; difficulty++)
+	{
+		std::printf("  level %d  %10u\n", difficulty, histogram[DealIndex::SOLVABLE | difficulty]);
+	}
+	std::printf("Unsolvable %10u\n", histogram[DealIndex::UNSOLVABLE]);
+	std::printf("Undecided  %10u\n", histogram[DealIndex::UNDECIDED]);
+	return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TOOLS_OPTIONS_H
+#define TOOLS_OPTIONS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*!
+ * \file options.h
+ * \brief Command line parsing shared by the command line tools
+ */
+
+/*!
+ * \brief Integer options of the command line, e.g. `--threads 8`
+ *
+ * The options follow the first argument, the command or the file the tool works on. A value that
+ * is not a whole number within the bounds of its option invalidates the command line, so that the
+ * tool shows its usage rather than run with a default or wrapped value.
+ */
+class Options
+{
+public:
+
+	//! Returned by a command of a tool whose options are invalid, to show the usage
+	static constexpr int USAGE = -1;
+
+public:
+
+	Options(int argc, char* argv[]) noexcept
+		: m_argc(argc)
+		, m_argv(argv)
+	{
+	}
+
+	/*!
+	 * \brief Read an option
+	 * \return The value of the option, or defaultValue if it is missing or invalid
+	 */
+	long get(const char* name, long defaultValue, long minimum = 1, long maximum = UINT32_MAX) noexcept
+	{
+		for (int i = 2; i + 1 < m_argc; i++)
+		{
+			if (std::strcmp(m_argv[i], name) == 0)
+			{
+				char* end	= nullptr;
+				long  value = std::strtol(m_argv[i + 1], &end, 10);
+				if (end == m_argv[i + 1] || *end != '\0' || value < minimum || value > maximum)
+				{
+					std::fprintf(stderr, "Invalid value for %s: %s\n", name, m_argv[i + 1]);
+					m_valid = false;
+					return defaultValue;
+				}
+				return value;
+			}
+		}
+		return defaultValue;
+	}
+
+	[[nodiscard]] bool isValid() const noexcept
+	{
+		return m_valid;
+	}
+
+protected:
+
+	int	   m_argc;
+	char** m_argv;
+	bool   m_valid = true;
+};
+
+#endif // TOOLS_OPTIONS_H
@@ -0,0 +1,445 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file solutions.cpp
+ * \brief Headless archive of solutions: solving ranges of deals, and text import and export
+ *
+ * Usage: freecell-solutions <command> <arguments> [options]
+ *
+ * Solutions are kept in solution files (see `SolutionFile`), and exchanged with other tools in
+ * the standard text notation (see notation.h), one solution per line.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gamestate.h"
+#include "mappedfile.h"
+#include "notation.h"
+#include "options.h"
+#include "solutionfile.h"
+#include "solver.h"
+
+namespace
+{
+	// Number of deals solved at once by a thread
+	constexpr std::uint32_t CHUNK_SIZE = 1024;
+
+	// Size of the text written to the output at once
+	constexpr std::size_t TEXT_BUFFER_SIZE = std::size_t(1) << 20;
+
+	// Size of the text parsed at once by all the threads
+	constexpr std::size_t IMPORT_BATCH_SIZE = std::size_t(64) << 20;
+
+	/*!
+	 * \brief Solutions of a range of deals or of text, moves back to back
+	 */
+	struct Chunk
+	{
+		std::vector<std::uint32_t> games;
+		std::vector<std::uint32_t> ends; //!< End of the moves of each game
+		std::vector<StateMove>	   moves;
+		bool					   done = false;
+	};
+
+	/*!
+	 * \brief Solve a range of deals on all the cores and write their solutions
+	 *
+	 * Chunks are solved in parallel and written in order as soon as all the previous ones are,
+	 * threads only running a bounded number of chunks ahead of the writer. Unsolved deals are
+	 * left out of the file.
+	 */
+	int solve(int argc, char* argv[])
+	{
+		if (argc < 3)
+		{
+			std::fprintf(stderr, "Missing solution file\n");
+			return 1;
+		}
+
+		Options		  options(argc, argv);
+		const char*	  path	  = argv[2];
+		std::uint32_t first	  = options.get("--first", 1'000'000);
+		std::uint32_t count	  = options.get("--count", 100'000);
+		unsigned int  threads = options.get("--threads", std::max(1u, std::thread::hardware_concurrency()));
+
+		SolverLimits limits;
+		limits.maxNodes	 = options.get("--nodes", 200'000);
+		limits.maxMemory = std::size_t(options.get("--memory", 256)) << 20;
+		if (!options.isValid() || first - 1 > UINT32_MAX - count)
+		{
+			return Options::USAGE;
+		}
+
+		SolutionWriter writer;
+		if (!writer.open(path))
+		{
+			std::fprintf(stderr, "Can't create %s\n", path);
+			return 1;
+		}
+
+		std::uint32_t			 chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		std::vector<Chunk>		 chunks(chunkCount);
+		std::atomic<std::size_t> next	 = 0;
+		std::uint32_t			 written = 0;
+		std::mutex				 mutex;
+		std::condition_variable	 drained;
+		auto					 start = std::chrono::steady_clock::now();
+
+		auto work = [&]()
+		{
+			Solver solver(limits);
+			for (std::size_t job = next++; job < chunkCount; job = next++)
+			{
+				{
+					std::unique_lock lock(mutex);
+					drained.wait(lock, [&] { return job < written + 4 * threads; });
+				}
+
+				Chunk		  chunk;
+				std::uint32_t begin = first + static_cast<std::uint32_t>(job) * CHUNK_SIZE;
+				std::uint32_t end	= first + std::min(static_cast<std::uint32_t>(job + 1) * CHUNK_SIZE, count);
+				for (std::uint32_t game = begin; game < end; game++)
+				{
+					if (solver.solve(GameState::fromGameNumber(game)) == Solver::Result::Solved)
+					{
+						chunk.games.push_back(game);
+						chunk.moves.insert(chunk.moves.end(), solver.solution().begin(), solver.solution().end());
+						chunk.ends.push_back(static_cast<std::uint32_t>(chunk.moves.size()));
+					}
+				}
+				chunk.done = true;
+
+				std::lock_guard lock(mutex);
+				chunks[job] = std::move(chunk);
+				for (; written < chunkCount && chunks[written].done; written++)
+				{
+					Chunk&		  ready = chunks[written];
+					std::uint32_t from	= 0;
+					for (std::size_t i = 0; i < ready.games.size(); i++)
+					{
+						writer.add(ready.games[i], ready.moves.data() + from, ready.ends[i] - from);
+						from = ready.ends[i];
+					}
+					ready = Chunk{};
+					ready.done = true;
+				}
+				drained.notify_all();
+
+				double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				std::fprintf(stderr, "\r%u/%u chunks written, %u solutions, %.0f deals/s   ", written, chunkCount, writer.count(),
+							 written * CHUNK_SIZE / seconds);
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for (unsigned int i = 0; i < threads; i++)
+		{
+			workers.emplace_back(work);
+		}
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+		std::fprintf(stderr, "\n");
+
+		if (!writer.close())
+		{
+			std::fprintf(stderr, "Can't write %s\n", path);
+			return 1;
+		}
+		std::printf("%u of %u deals solved\n", writer.count(), count);
+		return 0;
+	}
+
+	/*!
+	 * \brief Map a solution file
+	 * \return false if it isn't a solution file
+	 */
+	bool openSolutions(const char* path, MappedFile& mapping, SolutionFile& file)
+	{
+		if (!mapping.open(path))
+		{
+			std::fprintf(stderr, "Can't open %s\n", path);
+			return false;
+		}
+		file = SolutionFile(mapping.data(), mapping.size());
+		if (!file.isValid())
+		{
+			std::fprintf(stderr, "%s is not a complete solution file of this deal generator\n", path);
+			return false;
+		}
+		return true;
+	}
+
+	/*!
+	 * \brief Write the solutions of a solution file in text notation
+	 */
+	int exportText(int argc, char* argv[])
+	{
+		if (argc < 3)
+		{
+			std::fprintf(stderr, "Missing solution file\n");
+			return 1;
+		}
+
+		Options options(argc, argv);
+		long	game = options.get("--game", -1, 0);
+		if (!options.isValid())
+		{
+			return Options::USAGE;
+		}
+
+		MappedFile	 mapping;
+		SolutionFile file;
+		if (!openSolutions(argv[2], mapping, file))
+		{
+			return 1;
+		}
+
+		FILE* out = argc > 3 && argv[3][0] != '-' ? std::fopen(argv[3], "wb") : stdout;
+		if (!out)
+		{
+			std::fprintf(stderr, "Can't create %s\n", argv[3]);
+			return 1;
+		}
+
+		std::string			   text;
+		std::vector<StateMove> moves;
+		auto				   write = [&](const SolutionRecord& record)
+		{
+			moves.resize(record.moveCount);
+			for (int i = 0; i < record.moveCount; i++)
+			{
+				moves[i] = record.move(i);
+			}
+			formatSolution(record.gameNumber, moves.data(), moves.size(), text);
+			if (text.size() >= TEXT_BUFFER_SIZE)
+			{
+				std::fwrite(text.data(), 1, text.size(), out);
+				text.clear();
+			}
+		};
+
+		if (game >= 0)
+		{
+			SolutionRecord record;
+			if (!file.find(static_cast<std::uint32_t>(game), record))
+			{
+				std::fprintf(stderr, "No solution for game #%ld\n", game);
+				return 1;
+			}
+			write(record);
+		}
+		else
+		{
+			for (const SolutionRecord& record : file)
+			{
+				write(record);
+			}
+		}
+
+		std::fwrite(text.data(), 1, text.size(), out);
+		bool failed = std::ferror(out);
+		if (out != stdout)
+		{
+			failed = std::fclose(out) != 0 || failed;
+		}
+		if (failed)
+		{
+			std::fprintf(stderr, "Can't write the solutions\n");
+			return 1;
+		}
+		return 0;
+	}
+
+	/*!
+	 * \brief Parse the solution lines of a range of text, up to the first invalid one
+	 * \param error Receives the start of the invalid line, if any
+	 */
+	void parseRange(const char* begin, const char* end, Chunk& chunk, const char*& error)
+	{
+		std::uint32_t		   game = 0;
+		std::vector<StateMove> moves;
+		error = nullptr;
+		while (begin != end)
+		{
+			if (*begin == '\n' || *begin == '\r')
+			{
+				begin++;
+				continue;
+			}
+
+			const char* next = parseSolution(begin, end, game, moves);
+			if (!next)
+			{
+				error = begin;
+				return;
+			}
+			chunk.games.push_back(game);
+			chunk.moves.insert(chunk.moves.end(), moves.begin(), moves.end());
+			chunk.ends.push_back(static_cast<std::uint32_t>(chunk.moves.size()));
+			begin = next;
+		}
+	}
+
+	/*!
+	 * \brief Get the start of the line after a position
+	 */
+	const char* nextLine(const char* position, const char* end)
+	{
+		const char* newline = static_cast<const char*>(std::memchr(position, '\n', end - position));
+		return newline ? newline + 1 : end;
+	}
+
+	/*!
+	 * \brief Read solutions in text notation into a solution file
+	 *
+	 * The text is parsed by batches of IMPORT_BATCH_SIZE bytes, split on line boundaries between
+	 * all the cores, and every move is checked as it is parsed. The import stops at the first
+	 * invalid line.
+	 */
+	int importText(int argc, char* argv[])
+	{
+		if (argc < 4)
+		{
+			std::fprintf(stderr, "Missing text or solution file\n");
+			return 1;
+		}
+
+		Options		 options(argc, argv);
+		unsigned int threads = options.get("--threads", std::max(1u, std::thread::hardware_concurrency()));
+		if (!options.isValid())
+		{
+			return Options::USAGE;
+		}
+
+		MappedFile text;
+		if (!text.open(argv[2]))
+		{
+			std::fprintf(stderr, "Can't open %s\n", argv[2]);
+			return 1;
+		}
+
+		SolutionWriter writer;
+		if (!writer.open(argv[3]))
+		{
+			std::fprintf(stderr, "Can't create %s\n", argv[3]);
+			return 1;
+		}
+
+		const char*				 position = reinterpret_cast<const char*>(text.data());
+		const char*				 end	  = position + text.size();
+		std::vector<Chunk>		 chunks(threads);
+		std::vector<const char*> errors(threads);
+		auto					 start = std::chrono::steady_clock::now();
+		while (position != end)
+		{
+			const char*				 batchEnd = nextLine(position + std::min<std::size_t>(IMPORT_BATCH_SIZE, end - position) - 1, end);
+			std::vector<std::thread> workers;
+			for (unsigned int i = 0; i < threads; i++)
+			{
+				const char* rangeEnd = i + 1 == threads ? batchEnd : nextLine(position + (batchEnd - position) / threads, batchEnd);
+				chunks[i]			 = Chunk{};
+				workers.emplace_back(parseRange, position, rangeEnd, std::ref(chunks[i]), std::ref(errors[i]));
+				position = rangeEnd;
+			}
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+
+			for (unsigned int i = 0; i < threads; i++)
+			{
+				std::uint32_t from = 0;
+				for (std::size_t j = 0; j < chunks[i].games.size(); j++)
+				{
+					if (!writer.add(chunks[i].games[j], chunks[i].moves.data() + from, chunks[i].ends[j] - from))
+					{
+						std::fprintf(stderr, "Game #%u is out of order\n", chunks[i].games[j]);
+						return 1;
+					}
+					from = chunks[i].ends[j];
+				}
+				if (errors[i])
+				{
+					std::size_t line = std::count(reinterpret_cast<const char*>(text.data()), errors[i], '\n') + 1;
+					std::fprintf(stderr, "%s:%zu: invalid solution\n", argv[2], line);
+					return 1;
+				}
+			}
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (!writer.close())
+		{
+			std::fprintf(stderr, "Can't write %s\n", argv[3]);
+			return 1;
+		}
+		std::printf("%u solutions imported, %.0f MB/s\n", writer.count(), text.size() / seconds / 1e6);
+		return 0;
+	}
+
+	struct Command
+	{
+		const char* name;
+		int (*run)(int argc, char* argv[]);
+		const char* usage;
+	};
+
+	const Command COMMANDS[] = {
+		{"solve", solve, "solve <solution file> [--first 1000000] [--count 100000] [--threads <all cores>] [--nodes 200000] [--memory 256]"},
+		{"export", exportText, "export <solution file> [<text file>] [--game <n>]"},
+		{"import", importText, "import <text file> <solution file> [--threads <all cores>]"},
+	};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 2)
+	{
+		for (const auto& command : COMMANDS)
+		{
+			if (std::strcmp(argv[1], command.name) == 0)
+			{
+				int status = command.run(argc, argv);
+				if (status != Options::USAGE)
+				{
+					return status;
+				}
+			}
+		}
+	}
+
+	std::printf("Usage:\n");
+	for (const auto& command : COMMANDS)
+	{
+		std::printf("  %s %s\n", argv[0], command.usage);
+	}
+	return 1;
+}
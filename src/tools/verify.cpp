@@ -0,0 +1,227 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file verify.cpp
+ * \brief Headless verification of a solution file
+ *
+ * Usage: freecell-verify <solution file> [options]
+ *
+ * Every solution is replayed from the deal of its game number. Each move must be legal under
+ * `GameState::isLegal`, which mirrors `Card::canStackCard`, `Freecell::canStackCard` and
+ * `AceSpot::canStackCard`, and the final position must be won. The blocks of the file are
+ * spread over all the cores.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gamestate.h"
+#include "mappedfile.h"
+#include "notation.h"
+#include "options.h"
+#include "solutionfile.h"
+#include "supermove.h"
+
+namespace
+{
+	// Number of blocks of the file verified at once by a thread
+	constexpr std::uint32_t BLOCKS_PER_JOB = 64;
+
+	// Number of failures reported in detail
+	constexpr std::size_t MAX_REPORTED_FAILURES = 20;
+
+	/*!
+	 * \brief A solution that doesn't hold
+	 */
+	struct Failure
+	{
+		std::uint32_t gameNumber;
+		int			  move;	  //!< Rank of the failing move, the move count if the game isn't won
+		const char*	  reason; //!< What fails
+		char		  notation[MAX_NOTATION_LENGTH + 1];
+
+		bool operator<(const Failure& other) const noexcept
+		{
+			return gameNumber < other.gameNumber;
+		}
+	};
+
+	/*!
+	 * \brief Replay a solution
+	 * \param singleCards Whether to replay the moves of several cards as single-card moves
+	 * \param failure     Receives the reason of the failure
+	 * \return The number of moves replayed, -1 if the solution doesn't hold
+	 */
+	long replay(const SolutionRecord& record, bool singleCards, Failure& failure)
+	{
+		GameState state = GameState::fromGameNumber(record.gameNumber);
+		StateMove steps[MAX_SUPERMOVE_STEPS];
+		long	  replayed = 0;
+		for (int i = 0; i < record.moveCount; i++)
+		{
+			StateMove move	= record.move(i);
+			int		  count = 1;
+			steps[0]		= move;
+			if (singleCards && move.count > 1)
+			{
+				count = expandSupermove(state, move, steps);
+			}
+
+			if (!state.isLegal(move) || count == 0)
+			{
+				failure.gameNumber = record.gameNumber;
+				failure.move	   = i;
+				failure.reason	   = state.isLegal(move) ? "can't be played one card at a time" : "is illegal";
+				failure.notation[formatMove(state, move, failure.notation)] = '\0';
+				return -1;
+			}
+			for (int j = 0; j < count; j++)
+			{
+				// the expansion is checked as well, each step must follow the rules on its own
+				if (!state.isLegal(steps[j]))
+				{
+					failure.gameNumber = record.gameNumber;
+					failure.move	   = i;
+					failure.reason	   = "has an illegal single-card step";
+					failure.notation[formatMove(state, steps[j], failure.notation)] = '\0';
+					return -1;
+				}
+				state.apply(steps[j]);
+			}
+			replayed += count;
+		}
+
+		if (!state.isWon())
+		{
+			failure.gameNumber	= record.gameNumber;
+			failure.move		= record.moveCount;
+			failure.reason		= "doesn't win";
+			failure.notation[0] = '\0';
+			return -1;
+		}
+		return replayed;
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	Options		 options(argc, argv);
+	unsigned int threads	 = options.get("--threads", std::max(1u, std::thread::hardware_concurrency()));
+	bool		 singleCards = options.get("--single-cards", 0, 0, 1) != 0;
+
+	if (argc < 2 || argv[1][0] == '-' || !options.isValid())
+	{
+		std::printf("Usage: %s <solution file> [options]\n\n"
+					"Options:\n"
+					"  --threads <n>       number of threads (all cores)\n"
+					"  --single-cards 1    replay the moves of several cards one card at a time\n",
+					argv[0]);
+		return 1;
+	}
+
+	const char* path = argv[1];
+
+	MappedFile mapping;
+	if (!mapping.open(path))
+	{
+		std::fprintf(stderr, "Can't open %s\n", path);
+		return 1;
+	}
+	SolutionFile file(mapping.data(), mapping.size());
+	if (!file.isValid())
+	{
+		std::fprintf(stderr, "%s is not a complete solution file of this deal generator\n", path);
+		return 1;
+	}
+
+	std::uint32_t			   blocks	 = (file.count() + SolutionFile::BLOCK_SIZE - 1) / SolutionFile::BLOCK_SIZE;
+	std::atomic<std::uint32_t> next		 = 0;
+	std::atomic<long>		   moves	 = 0;
+	std::atomic<long>		   solutions = 0;
+	std::vector<Failure>	   failures;
+	std::mutex				   failureMutex;
+	auto					   start = std::chrono::steady_clock::now();
+
+	auto verify = [&]()
+	{
+		long				 localMoves		= 0;
+		long				 localSolutions = 0;
+		std::vector<Failure> localFailures;
+		for (std::uint32_t first = next.fetch_add(BLOCKS_PER_JOB); first < blocks; first = next.fetch_add(BLOCKS_PER_JOB))
+		{
+			std::uint32_t last = std::min(first + BLOCKS_PER_JOB, blocks);
+			auto		  it   = file.blockBegin(first);
+			auto		  end  = last < blocks ? file.blockBegin(last) : file.end();
+			for (; it != end; ++it)
+			{
+				Failure failure;
+				long	replayed = replay(*it, singleCards, failure);
+				if (replayed < 0)
+				{
+					localFailures.push_back(failure);
+				}
+				else
+				{
+					localMoves += replayed;
+				}
+				localSolutions++;
+			}
+		}
+
+		moves += localMoves;
+		solutions += localSolutions;
+		std::lock_guard lock(failureMutex);
+		failures.insert(failures.end(), localFailures.begin(), localFailures.end());
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		workers.emplace_back(verify);
+	}
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::sort(failures.begin(), failures.end());
+	for (std::size_t i = 0; i < std::min(failures.size(), MAX_REPORTED_FAILURES); i++)
+	{
+		const Failure& failure = failures[i];
+		if (failure.notation[0])
+		{
+			std::printf("Game #%u: move %d (%s) %s\n", failure.gameNumber, failure.move + 1, failure.notation, failure.reason);
+		}
+		else
+		{
+			std::printf("Game #%u: the solution of %d moves %s\n", failure.gameNumber, failure.move, failure.reason);
+		}
+	}
+
+	std::printf("%ld of %u solutions verified, %zu failed\n", solutions.load() - long(failures.size()), file.count(), failures.size());
+	std::printf("%ld %smoves in %.2f s: %.1fM moves/s, %.1fM moves/s per thread\n", moves.load(), singleCards ? "single-card " : "",
+				seconds, moves / seconds / 1e6, moves / seconds / 1e6 / threads);
+	return failures.empty() && solutions == long(file.count()) ? 0 : 1;
+}
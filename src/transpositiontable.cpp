@@ -0,0 +1,134 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "transpositiontable.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+	// 0 marks an empty bucket
+	constexpr std::uint64_t storedKey(std::uint64_t key) noexcept
+	{
+		return key ? key : 1;
+	}
+} // namespace
+
+/*!
+ * \brief Constructor
+ * \param initialCapacity Number of buckets to start with, rounded up to a power of two
+ */
+TranspositionTable::TranspositionTable(std::size_t initialCapacity)
+{
+	m_keys.assign(std::bit_ceil(initialCapacity < 16 ? std::size_t(16) : initialCapacity), 0);
+	m_mask = m_keys.size() - 1;
+}
+
+/*!
+ * \brief Add a position to the table
+ * \param key The hash of the position
+ * \return true if the position wasn't in the table yet
+ */
+bool TranspositionTable::insert(std::uint64_t key)
+{
+	if (2 * (m_size + 1) > m_keys.size())
+	{
+		grow();
+	}
+
+	key			  = storedKey(key);
+	std::size_t i = key & m_mask;
+	while (m_keys[i])
+	{
+		if (m_keys[i] == key)
+		{
+			return false;
+		}
+		i = (i + 1) & m_mask;
+	}
+
+	m_keys[i] = key;
+	m_size++;
+	return true;
+}
+
+/*!
+ * \brief Check if a position is in the table
+ * \param key The hash of the position
+ */
+bool TranspositionTable::contains(std::uint64_t key) const noexcept
+{
+	key			  = storedKey(key);
+	std::size_t i = key & m_mask;
+	while (m_keys[i])
+	{
+		if (m_keys[i] == key)
+		{
+			return true;
+		}
+		i = (i + 1) & m_mask;
+	}
+	return false;
+}
+
+/*!
+ * \brief Forget every position, keeping the allocated buckets
+ */
+void TranspositionTable::clear()
+{
+	std::fill(m_keys.begin(), m_keys.end(), 0);
+	m_size = 0;
+}
+
+std::size_t TranspositionTable::size() const noexcept
+{
+	return m_size;
+}
+
+/*!
+ * \brief Get the memory held by the buckets, in bytes
+ */
+std::size_t TranspositionTable::memoryUsage() const noexcept
+{
+	return m_keys.capacity() * sizeof(std::uint64_t);
+}
+
+/*!
+ * \brief Double the number of buckets and re-insert every key
+ */
+void TranspositionTable::grow()
+{
+	std::vector<std::uint64_t> keys(m_keys.size() * 2, 0);
+	std::size_t				   mask = keys.size() - 1;
+
+	for (auto key : m_keys)
+	{
+		if (key)
+		{
+			std::size_t i = key & mask;
+			while (keys[i])
+			{
+				i = (i + 1) & mask;
+			}
+			keys[i] = key;
+		}
+	}
+
+	m_keys.swap(keys);
+	m_mask = mask;
+}
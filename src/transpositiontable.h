@@ -0,0 +1,55 @@
+/*
+ * This file is part of Freecell.
+ *
+ * Freecell is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * Freecell is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Freecell.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * \brief Set of already visited positions, keyed by their 64 bit hash
+ *
+ * Open addressing with linear probing over a power of two array of keys. The table doubles
+ * when it gets half full. Two positions sharing a hash are considered identical.
+ */
+class TranspositionTable
+{
+public:
+
+	explicit TranspositionTable(std::size_t initialCapacity = 1 << 16);
+
+	bool			   insert(std::uint64_t key);
+	[[nodiscard]] bool contains(std::uint64_t key) const noexcept;
+	void			   clear();
+
+	[[nodiscard]] std::size_t size() const noexcept;
+	[[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+protected:
+
+	void grow();
+
+protected:
+
+	std::vector<std::uint64_t> m_keys;
+	std::size_t				   m_mask = 0;
+	std::size_t				   m_size = 0;
+};
+
+#endif // TRANSPOSITIONTABLE_H